@@ -0,0 +1,23 @@
+# Record the calls to the solvers while solving an example with clingo-lpx and
+# replay them checking that all results match the recording.
+#
+# The script expects variables CLINGOLPX, REPLAY, ENCODING, INSTANCE, and
+# RECORD holding the paths to the executables, the example files, and the
+# record file.
+
+execute_process(
+    COMMAND "${CLINGOLPX}" "${ENCODING}" "${INSTANCE}" -c n=132 5 --store=partial "--record=${RECORD}"
+    OUTPUT_QUIET
+    RESULT_VARIABLE result)
+# clingo's exit codes are 10, 20, and 30 for (un)satisfiable and exhausted
+# searches
+if (NOT result MATCHES "^(10|20|30)$")
+    message(FATAL_ERROR "recording failed with exit code ${result}")
+endif()
+
+execute_process(
+    COMMAND "${REPLAY}" --check --store=partial "${RECORD}"
+    RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "replay failed with exit code ${result}")
+endif()
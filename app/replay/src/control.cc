@@ -0,0 +1,269 @@
+// {{{ MIT License
+
+// Copyright Roland Kaminski
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+// }}}
+
+#include "control.hh"
+
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+
+// assignment
+
+auto clingo_assignment::value(clingo_literal_t lit) const -> int {
+    auto var = static_cast<size_t>(std::abs(lit));
+    if (var >= values.size()) {
+        return 0;
+    }
+    return lit > 0 ? values[var] : -values[var];
+}
+
+auto clingo_assignment::level(clingo_literal_t lit) const -> uint32_t {
+    auto var = static_cast<size_t>(std::abs(lit));
+    return var < levels.size() ? levels[var] : 0;
+}
+
+void clingo_assignment::assign(clingo_literal_t lit) {
+    auto var = static_cast<size_t>(std::abs(lit));
+    if (var >= values.size()) {
+        values.resize(var + 1, 0);
+        levels.resize(var + 1, 0);
+    }
+    if (values[var] == 0) {
+        values[var] = static_cast<int8_t>(lit > 0 ? 1 : -1);
+        levels[var] = decision_level;
+        trail.emplace_back(lit);
+    }
+}
+
+void clingo_assignment::backtrack(uint32_t level) {
+    while (!trail.empty()) {
+        auto var = static_cast<size_t>(std::abs(trail.back()));
+        if (levels[var] < level) {
+            break;
+        }
+        values[var] = 0;
+        levels[var] = 0;
+        trail.pop_back();
+    }
+    decision_level = level > 0 ? level - 1 : 0;
+    total = false;
+    conflict = false;
+}
+
+auto clingo_assignment::add_clause(clingo_literal_t const *clause, size_t size) -> bool {
+    clingo_literal_t unit = 0;
+    size_t n_free = 0;
+    for (auto const *it = clause, *ie = clause + size; it != ie; ++it) { // NOLINT
+        auto val = value(*it);
+        if (val > 0) {
+            return true;
+        }
+        if (val == 0) {
+            unit = *it;
+            ++n_free;
+        }
+    }
+    if (n_free == 0) {
+        conflict = true;
+        return false;
+    }
+    if (n_free == 1) {
+        assign(unit);
+    }
+    return true;
+}
+
+extern "C" {
+
+// NOLINTBEGIN(readability-identifier-naming)
+
+auto clingo_assignment_decision_level(clingo_assignment_t const *assignment) -> uint32_t {
+    return assignment->decision_level;
+}
+
+auto clingo_assignment_has_conflict(clingo_assignment_t const *assignment) -> bool { return assignment->conflict; }
+
+auto clingo_assignment_has_literal(clingo_assignment_t const *assignment, clingo_literal_t literal) -> bool {
+    static_cast<void>(assignment);
+    return literal != 0;
+}
+
+auto clingo_assignment_truth_value(clingo_assignment_t const *assignment, clingo_literal_t literal,
+                                   clingo_truth_value_t *value) -> bool {
+    auto val = assignment->value(literal);
+    *value = val > 0 ? clingo_truth_value_true : val < 0 ? clingo_truth_value_false : clingo_truth_value_free;
+    return true;
+}
+
+auto clingo_assignment_level(clingo_assignment_t const *assignment, clingo_literal_t literal, uint32_t *level)
+    -> bool {
+    *level = assignment->level(literal);
+    return true;
+}
+
+auto clingo_assignment_is_fixed(clingo_assignment_t const *assignment, clingo_literal_t literal, bool *is_fixed)
+    -> bool {
+    *is_fixed = assignment->value(literal) != 0 && assignment->level(literal) == 0;
+    return true;
+}
+
+auto clingo_assignment_is_true(clingo_assignment_t const *assignment, clingo_literal_t literal, bool *is_true)
+    -> bool {
+    *is_true = assignment->value(literal) > 0;
+    return true;
+}
+
+auto clingo_assignment_is_false(clingo_assignment_t const *assignment, clingo_literal_t literal, bool *is_false)
+    -> bool {
+    *is_false = assignment->value(literal) < 0;
+    return true;
+}
+
+auto clingo_assignment_is_total(clingo_assignment_t const *assignment) -> bool { return assignment->total; }
+
+// propagate control
+
+auto clingo_propagate_control_thread_id(clingo_propagate_control_t const *control) -> clingo_id_t {
+    return control->thread_id;
+}
+
+auto clingo_propagate_control_assignment(clingo_propagate_control_t const *control) -> clingo_assignment_t const * {
+    return &control->assignment;
+}
+
+auto clingo_propagate_control_add_literal(clingo_propagate_control_t *control, clingo_literal_t *result) -> bool {
+    *result = control->next_var++;
+    return true;
+}
+
+auto clingo_propagate_control_add_watch(clingo_propagate_control_t *control, clingo_literal_t literal) -> bool {
+    static_cast<void>(control);
+    static_cast<void>(literal);
+    return true;
+}
+
+auto clingo_propagate_control_add_clause(clingo_propagate_control_t *control, clingo_literal_t const *clause,
+                                         size_t size, clingo_clause_type_t type, bool *result) -> bool {
+    static_cast<void>(type);
+    *result = control->assignment.add_clause(clause, size);
+    return true;
+}
+
+auto clingo_propagate_control_propagate(clingo_propagate_control_t *control, bool *result) -> bool {
+    *result = !control->assignment.conflict;
+    return true;
+}
+
+// propagate init
+
+auto clingo_propagate_init_solver_literal(clingo_propagate_init_t const *init, clingo_literal_t aspif_literal,
+                                          clingo_literal_t *solver_literal) -> bool {
+    static_cast<void>(init);
+    *solver_literal = aspif_literal;
+    return true;
+}
+
+auto clingo_propagate_init_add_watch(clingo_propagate_init_t *init, clingo_literal_t solver_literal) -> bool {
+    static_cast<void>(init);
+    static_cast<void>(solver_literal);
+    return true;
+}
+
+auto clingo_propagate_init_number_of_threads(clingo_propagate_init_t const *init) -> int { return init->n_threads; }
+
+auto clingo_propagate_init_assignment(clingo_propagate_init_t const *init) -> clingo_assignment_t const * {
+    return &init->assignment;
+}
+
+auto clingo_propagate_init_add_clause(clingo_propagate_init_t *init, clingo_literal_t const *clause, size_t size,
+                                      bool *result) -> bool {
+    *result = init->assignment.add_clause(clause, size);
+    return true;
+}
+
+auto clingo_propagate_init_propagate(clingo_propagate_init_t *init, bool *result) -> bool {
+    *result = !init->assignment.conflict;
+    return true;
+}
+
+// symbols
+//
+// Variables in recordings are given as numbers. Hence, only number symbols
+// are supported, which are stored as the number itself.
+
+void clingo_symbol_create_number(int number, clingo_symbol_t *symbol) {
+    *symbol = static_cast<clingo_symbol_t>(static_cast<uint32_t>(number));
+}
+
+auto clingo_symbol_number(clingo_symbol_t symbol, int *number) -> bool {
+    *number = static_cast<int>(static_cast<uint32_t>(symbol));
+    return true;
+}
+
+auto clingo_symbol_type(clingo_symbol_t symbol) -> clingo_symbol_type_t {
+    static_cast<void>(symbol);
+    return clingo_symbol_type_number;
+}
+
+auto clingo_symbol_to_string_size(clingo_symbol_t symbol, size_t *size) -> bool {
+    *size = std::to_string(static_cast<int>(static_cast<uint32_t>(symbol))).size() + 1;
+    return true;
+}
+
+auto clingo_symbol_to_string(clingo_symbol_t symbol, char *string, size_t size) -> bool {
+    auto str = std::to_string(static_cast<int>(static_cast<uint32_t>(symbol)));
+    std::strncpy(string, str.c_str(), size);
+    return true;
+}
+
+auto clingo_symbol_is_equal_to(clingo_symbol_t a, clingo_symbol_t b) -> bool { return a == b; }
+
+auto clingo_symbol_is_less_than(clingo_symbol_t a, clingo_symbol_t b) -> bool {
+    return static_cast<int>(static_cast<uint32_t>(a)) < static_cast<int>(static_cast<uint32_t>(b));
+}
+
+auto clingo_symbol_hash(clingo_symbol_t symbol) -> size_t { return std::hash<clingo_symbol_t>{}(symbol); }
+
+// errors
+//
+// None of the functions above fails. Hence, there is never an error to
+// report.
+
+auto clingo_error_code() -> clingo_error_t { return clingo_error_success; }
+
+auto clingo_error_message() -> char const * { return nullptr; }
+
+auto clingo_error_string(clingo_error_t code) -> char const * {
+    static_cast<void>(code);
+    return "no error";
+}
+
+void clingo_set_error(clingo_error_t code, char const *message) {
+    static_cast<void>(code);
+    static_cast<void>(message);
+}
+
+// NOLINTEND(readability-identifier-naming)
+}
@@ -0,0 +1,86 @@
+// {{{ MIT License
+
+// Copyright Roland Kaminski
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+// }}}
+
+#pragma once
+
+// The replay tool does not link against clingo. Instead, it implements the
+// parts of clingo's C API used by the solvers. The structures below complete
+// the opaque types of the API and hold the state reconstructed from a
+// recording.
+
+#include <clingo.h>
+
+#include <cstdint>
+#include <vector>
+
+//! An assignment of literals built from the calls recorded for a thread.
+//!
+//! Literals passed to the solver are assigned on the recorded decision
+//! level. Unit clauses added by the solver assign their literal on the
+//! current decision level. Unit propagation beyond that is not performed.
+struct clingo_assignment {
+    //! Get the truth value of a literal.
+    //!
+    //! Returns 1 if the literal is true, -1 if it is false, and 0 otherwise.
+    [[nodiscard]] auto value(clingo_literal_t lit) const -> int;
+    //! Get the decision level on which the literal has been assigned.
+    [[nodiscard]] auto level(clingo_literal_t lit) const -> uint32_t;
+    //! Make the literal true on the current decision level.
+    //!
+    //! Literals that are already assigned keep their value.
+    void assign(clingo_literal_t lit);
+    //! Remove all assignments on the given level and above.
+    void backtrack(uint32_t level);
+    //! Add a clause.
+    //!
+    //! Returns false if all literals in the clause are false.
+    [[nodiscard]] auto add_clause(clingo_literal_t const *clause, size_t size) -> bool;
+
+    //! The values of variables (1 for true, -1 for false, and 0 for free).
+    std::vector<int8_t> values;
+    //! The decision levels of variables.
+    std::vector<uint32_t> levels;
+    //! The assigned literals in chronological order.
+    std::vector<clingo_literal_t> trail;
+    //! The current decision level.
+    uint32_t decision_level{0};
+    //! Whether the assignment is total.
+    bool total{false};
+    //! Whether the last added clause was conflicting.
+    bool conflict{false};
+};
+
+//! The control object passed to a solver thread.
+struct clingo_propagate_control {
+    clingo_assignment assignment;
+    clingo_id_t thread_id{0};
+    //! The next variable returned when adding literals.
+    clingo_literal_t next_var{1};
+};
+
+//! The object passed to solvers during initialization.
+struct clingo_propagate_init {
+    clingo_assignment assignment;
+    int n_threads{1};
+};
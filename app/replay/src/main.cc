@@ -0,0 +1,353 @@
+// {{{ MIT License
+
+// Copyright Roland Kaminski
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+// }}}
+
+#include "control.hh"
+
+#include <record.hh>
+#include <solving.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+//! Replay a recording driving one solver per recorded thread.
+//!
+//! The calls are replayed in the recorded order. The assignment seen by a
+//! solver consists of the recorded literals and the literals of unit clauses
+//! added by the solver. Sharing of facts and of objective values between
+//! threads is not replayed.
+template <typename Value, typename Matrix> class Replay {
+  public:
+    Replay(Options options) : options_{std::move(options)} {}
+
+    //! Replay all entries of the given recording.
+    void run(RecordReader &reader) {
+        RecordEntry entry;
+        while (reader.read(entry)) {
+            ++calls_;
+            switch (entry.tag) {
+                case RecordTag::Init: {
+                    init_(entry);
+                    break;
+                }
+                case RecordTag::Solve: {
+                    auto &ctl = control_(entry);
+                    ctl.assignment.decision_level = entry.level;
+                    for (auto lit : entry.literals) {
+                        ctl.assignment.assign(lit);
+                    }
+                    Clingo::PropagateControl pctl{&ctl};
+                    if (slvs_[entry.thread_id].solve(pctl, {entry.literals.data(), entry.literals.size()}) !=
+                        entry.result) {
+                        ++mismatches_;
+                    }
+                    break;
+                }
+                case RecordTag::Undo: {
+                    auto &ctl = control_(entry);
+                    slvs_[entry.thread_id].undo();
+                    ctl.assignment.backtrack(entry.level);
+                    break;
+                }
+                case RecordTag::Check: {
+                    auto &ctl = control_(entry);
+                    auto &slv = slvs_[entry.thread_id];
+                    ctl.assignment.decision_level = entry.level;
+                    ctl.assignment.total = true;
+                    slv.optimize();
+                    if (thread_options_[entry.thread_id].store_sat_assignment >= StoreSATAssignments::Partial) {
+                        slv.store_sat_assignment();
+                    }
+                    ctl.assignment.total = false;
+                    break;
+                }
+            }
+        }
+        accumulate_();
+    }
+
+    //! Print the number of replayed calls and the accumulated statistics.
+    void print(double time) const {
+        std::cout << "Calls      : " << calls_ << "\n";
+        std::cout << "Mismatches : " << mismatches_ << "\n";
+        std::cout << "Time       : " << time << "s\n";
+        std::cout << "Pivots     : " << stats_.pivots << "\n";
+        std::cout << "Conflicts  : " << stats_.conflicts << "\n";
+        std::cout << "Propagated : " << stats_.propagated_bounds << "\n";
+        std::cout << "Solve      : " << stats_.time_solve << "s\n";
+#ifdef CLINGOLPX_TIMERS
+        std::cout << "  Select   : " << stats_.time_select << "s\n";
+        std::cout << "  Pivot    : " << stats_.time_pivot << "s\n";
+#endif
+        std::cout << "  Propagate: " << stats_.time_propagate << "s\n";
+#ifdef CLINGOLPX_TIMERS
+        std::cout << "Optimize   : " << stats_.time_optimize << "s\n";
+        std::cout << "Undo       : " << stats_.time_undo << "s\n";
+#endif
+    }
+
+    //! Get the number of solve calls whose results differ from the recorded
+    //! ones.
+    [[nodiscard]] auto mismatches() const -> size_t { return mismatches_; }
+
+  private:
+    //! Get the control object of the thread of the given entry.
+    auto control_(RecordEntry const &entry) -> clingo_propagate_control & {
+        if (entry.thread_id >= ctls_.size()) {
+            throw std::runtime_error("invalid thread in record file");
+        }
+        return ctls_[entry.thread_id];
+    }
+
+    //! Initialize the solvers mirroring Propagator::init.
+    void init_(RecordEntry &entry) {
+        if (entry.offset != iqs_.size()) {
+            throw std::runtime_error("inconsistent inequalities in record file");
+        }
+        auto n_objective = objective_.size();
+        std::move(entry.inequalities.begin(), entry.inequalities.end(), std::back_inserter(iqs_));
+        objective_ = std::move(entry.objective);
+
+        clingo_literal_t max_var = 1;
+        auto gather_vars = [&](std::vector<Term> const &terms) {
+            for (auto const &term : terms) {
+                vars_.emplace(term.var, static_cast<index_t>(term.var.number()));
+            }
+        };
+        gather_vars(objective_);
+        for (auto const &x : iqs_) {
+            gather_vars(x.lhs);
+            max_var = std::max(max_var, std::abs(x.lit));
+        }
+
+        clingo_propagate_init init;
+        init.n_threads = static_cast<int>(entry.n_threads);
+        init.assignment.assign(1);
+        for (auto lit : entry.literals) {
+            init.assignment.assign(lit);
+        }
+        Clingo::PropagateInit pinit{&init};
+
+        if (slvs_.size() == entry.n_threads && objective_.size() == n_objective &&
+            std::all_of(slvs_.begin(), slvs_.end(), [](auto const &slv) { return slv.extensible(); })) {
+            for (size_t i = 0; i != entry.n_threads; ++i) {
+                if (!slvs_[i].extend(pinit, vars_, iqs_, entry.offset, i == 0)) {
+                    break;
+                }
+            }
+        } else {
+            accumulate_();
+            slvs_.clear();
+            thread_options_.clear();
+            for (size_t i = 0; i != entry.n_threads; ++i) {
+                thread_options_.emplace_back(thread_options(options_, i));
+            }
+            slvs_.reserve(entry.n_threads);
+            for (size_t i = 0; i != entry.n_threads; ++i) {
+                slvs_.emplace_back(thread_options_[i]);
+                if (!slvs_.back().prepare(pinit, vars_, iqs_, objective_, i == 0)) {
+                    break;
+                }
+            }
+        }
+
+        ctls_.clear();
+        ctls_.resize(entry.n_threads);
+        for (size_t i = 0; i != entry.n_threads; ++i) {
+            ctls_[i].assignment = init.assignment;
+            ctls_[i].thread_id = static_cast<Clingo::id_t>(i);
+            ctls_[i].next_var = max_var + 1;
+        }
+    }
+
+    //! Add the statistics of the current solvers to the accumulated ones.
+    void accumulate_() {
+        for (auto const &slv : slvs_) {
+            auto const &stats = slv.statistics();
+            stats_.pivots += stats.pivots;
+            stats_.conflicts += stats.conflicts;
+            stats_.propagated_bounds += stats.propagated_bounds;
+            stats_.time_solve += stats.time_solve;
+            stats_.time_select += stats.time_select;
+            stats_.time_pivot += stats.time_pivot;
+            stats_.time_propagate += stats.time_propagate;
+            stats_.time_optimize += stats.time_optimize;
+            stats_.time_undo += stats.time_undo;
+        }
+    }
+
+    Options options_;
+    // Note that the solvers store references to their options.
+    std::vector<Options> thread_options_;
+    std::vector<Inequality> iqs_;
+    std::vector<Term> objective_;
+    SymbolMap vars_;
+    std::vector<Solver<Value, Matrix>> slvs_;
+    std::vector<clingo_propagate_control> ctls_;
+    Statistics stats_;
+    size_t calls_{0};
+    size_t mismatches_{0};
+};
+
+//! Parse one of the given values.
+template <typename T> auto parse_choice(char const *value, std::initializer_list<std::pair<char const *, T>> choices,
+                                        T &result) -> bool {
+    for (auto const &[name, choice] : choices) {
+        if (std::strcmp(value, name) == 0) {
+            result = choice;
+            return true;
+        }
+    }
+    return false;
+}
+
+//! Parse a command line option.
+auto parse_option(char const *arg, Options &options, bool &revised) -> bool {
+    auto const *eq = std::strchr(arg, '=');
+    auto key = eq != nullptr ? std::string(arg, eq) : std::string(arg);
+    char const *value = eq != nullptr ? eq + 1 : nullptr; // NOLINT
+    if (value == nullptr) {
+        for (auto [name, flag] : {std::pair{"lazy-rows", &options.lazy_rows},
+                                  std::pair{"eliminate-fixed", &options.eliminate_fixed},
+                                  std::pair{"propagate-conflicts", &options.propagate_conflicts}}) {
+            if (key == std::string("--") + name || key == std::string("--no-") + name) {
+                *flag = key.compare(0, 5, "--no-") != 0; // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+                return true;
+            }
+        }
+        return false;
+    }
+    if (key == "--engine") {
+        return parse_choice(value, {{"tableau", false}, {"revised", true}}, revised);
+    }
+    if (key == "--propagate-bounds") {
+        return parse_choice(
+            value, {{"none", PropagateMode::None}, {"changed", PropagateMode::Changed}, {"full", PropagateMode::Full}},
+            options.propagate_mode);
+    }
+    if (key == "--store") {
+        return parse_choice(value,
+                            {{"no", StoreSATAssignments::No},
+                             {"partial", StoreSATAssignments::Partial},
+                             {"total", StoreSATAssignments::Total}},
+                            options.store_sat_assignment);
+    }
+    if (key == "--entering") {
+        return parse_choice(value, {{"bland", EnteringRule::Bland}, {"markowitz", EnteringRule::Markowitz}},
+                            options.entering);
+    }
+    if (key == "--refresh") {
+        char *end = nullptr;
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+        options.refresh_factor = std::strtoul(value, &end, 10);
+        options.refresh_restart = std::strcmp(end, ",restart") == 0;
+        return end != value && (*end == '\0' || options.refresh_restart);
+    }
+    return false;
+}
+
+//! Replay the recording with the given value and matrix types.
+//!
+//! Returns the number of mismatching solve calls.
+template <typename Value, typename Matrix> auto replay(RecordReader &reader, Options const &options) -> size_t {
+    Replay<Value, Matrix> replay{options};
+    auto start = std::chrono::steady_clock::now();
+    replay.run(reader);
+    replay.print(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return replay.mismatches();
+}
+
+constexpr char const *USAGE = R"(usage: clingo-lpx-replay [options] <file>
+
+Replay calls to the solvers recorded with option --record of clingo-lpx.
+With option --check, the replay fails if a result differs from the recording.
+
+Options:
+  --check
+  --engine={tableau,revised}
+  --propagate-bounds={none,changed,full}
+  --store={no,partial,total}
+  --entering={bland,markowitz}
+  --refresh=<factor>[,restart]
+  --[no-]lazy-rows
+  --[no-]eliminate-fixed
+  --[no-]propagate-conflicts
+)";
+
+} // namespace
+
+auto main(int argc, char *argv[]) -> int {
+    try {
+        Options options;
+        bool revised = false;
+        bool check = false;
+        char const *file = nullptr;
+        for (int i = 1; i < argc; ++i) {
+            char const *arg = argv[i]; // NOLINT
+            if (std::strncmp(arg, "--", 2) != 0 && file == nullptr) {
+                file = arg;
+            } else if (std::strcmp(arg, "--check") == 0) {
+                check = true;
+            } else if (!parse_option(arg, options, revised)) {
+                std::cerr << "error: invalid option " << arg << "\n\n" << USAGE;
+                return EXIT_FAILURE;
+            }
+        }
+        if (file == nullptr) {
+            std::cerr << USAGE;
+            return EXIT_FAILURE;
+        }
+        if (options.lazy_rows && options.store_sat_assignment != StoreSATAssignments::Partial) {
+            std::cerr << "error: --lazy-rows requires --store=partial\n";
+            return EXIT_FAILURE;
+        }
+        RecordReader reader{file};
+        size_t mismatches = 0;
+        if (reader.strict()) {
+            mismatches = revised ? replay<RationalQ, RevisedTableau>(reader, options)
+                                 : replay<RationalQ, Tableau>(reader, options);
+        } else {
+            mismatches = revised ? replay<Rational, RevisedTableau>(reader, options)
+                                 : replay<Rational, Tableau>(reader, options);
+        }
+        if (check && mismatches > 0) {
+            std::cerr << "error: " << mismatches << " replayed results differ from the recording\n";
+            return EXIT_FAILURE;
+        }
+    } catch (std::exception const &e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
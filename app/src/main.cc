@@ -25,10 +25,18 @@
 #include <clingo-lpx-app/app.hh>
 #include <clingo-lpx.h>
 #include <clingo.hh>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
 #include <fstream>
+#include <iostream>
 #include <limits>
 #include <optional>
 #include <sstream>
+#include <string>
+#include <vector>
 #ifdef CLINGOLPX_PROFILE
 #include <gperftools/profiler.h>
 #endif
@@ -51,6 +59,81 @@ class Profiler {
 
 using Clingo::Detail::handle_error;
 
+namespace {
+
+//! Append an integer to the given string.
+void append_int(std::string &out, int64_t x) {
+    std::array<char, std::numeric_limits<int64_t>::digits10 + 3> buf{};
+    auto res = std::to_chars(buf.data(), buf.data() + buf.size(), x);
+    out.append(buf.data(), res.ptr);
+}
+
+//! Append a fraction to the given string omitting denominator one.
+void append_fraction(std::string &out, int64_t num, int64_t den) {
+    append_int(out, num);
+    if (den != 1) {
+        out.push_back('/');
+        append_int(out, den);
+    }
+}
+
+//! Append a rational value of the assignment to the given string.
+//!
+//! The value is formatted in the same way as by the theory.
+void append_rational(std::string &out, clingolpx_rational_t const &x) {
+    if (x.numerator != 0 || x.epsilon_numerator == 0) {
+        append_fraction(out, x.numerator, x.denominator);
+    }
+    if (x.epsilon_numerator != 0) {
+        if (x.numerator != 0) {
+            out.push_back('+');
+        }
+        if (x.epsilon_numerator != 1 || x.epsilon_denominator != 1) {
+            append_fraction(out, x.epsilon_numerator, x.epsilon_denominator);
+            out.push_back('*');
+        }
+        out.push_back('e');
+    }
+}
+
+//! Append a string as a quoted and escaped JSON string.
+void append_json_string(std::string &out, std::string const &str) {
+    static constexpr char const *hex = "0123456789abcdef";
+    out.push_back('"');
+    for (auto c : str) {
+        switch (c) {
+            case '"': {
+                out.append("\\\"");
+                break;
+            }
+            case '\\': {
+                out.append("\\\\");
+                break;
+            }
+            case '\n': {
+                out.append("\\n");
+                break;
+            }
+            case '\t': {
+                out.append("\\t");
+                break;
+            }
+            default: {
+                if (static_cast<unsigned char>(c) < 0x20) { // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+                    out.append("\\u00");
+                    out.push_back(hex[static_cast<unsigned char>(c) >> 4U]);  // NOLINT
+                    out.push_back(hex[static_cast<unsigned char>(c) & 0xFU]); // NOLINT
+                } else {
+                    out.push_back(c);
+                }
+            }
+        }
+    }
+    out.push_back('"');
+}
+
+} // namespace
+
 //! Application class to run clingo-lpx.
 class App : public Clingo::Application, private Clingo::SolveEventHandler {
   public:
@@ -64,44 +147,81 @@ class App : public Clingo::Application, private Clingo::SolveEventHandler {
     [[nodiscard]] auto program_name() const noexcept -> char const * override { return "clingo-lpx"; }
     //! Set the version.
     [[nodiscard]] auto version() const noexcept -> char const * override { return CLINGOLPX_VERSION; }
+    //! Print the model streaming the shown values from the assignment.
+    //!
+    //! Values are printed in index order and formatted without going through
+    //! the symbols added to the model.
     void print_model(Clingo::Model const &model, std::function<void()> default_printer) noexcept override {
         static_cast<void>(default_printer);
         try {
+            auto thread_id = model.thread_id();
+            size_t const *indices = nullptr;
+            size_t size = 0;
+            handle_error(clingolpx_assignment_get_shown(theory_, thread_id, &indices, &size));
+            values_.resize(size);
+            handle_error(clingolpx_assignment_get_values(theory_, thread_id, indices, size, values_.data()));
+            bool has_objective = false;
+            bool bounded = false;
+            clingolpx_value_t objective{};
+            handle_error(clingolpx_assignment_get_objective(theory_, thread_id, &has_objective, &objective, &bounded));
             auto symbols = model.symbols();
             std::sort(symbols.begin(), symbols.end());
-            bool comma = false;
-            for (auto const &sym : symbols) {
-                if (comma) {
-                    std::cout << " ";
+
+            out_.clear();
+            if (json_) {
+                out_.append("{\"atoms\":[");
+                bool comma = false;
+                for (auto const &sym : symbols) {
+                    if (comma) {
+                        out_.push_back(',');
+                    }
+                    append_json_string(out_, sym.to_string());
+                    comma = true;
                 }
-                std::cout << sym;
-                comma = true;
-            }
-            std::cout << "\nAssignment:\n";
-            symbols = model.symbols(Clingo::ShowType::Theory);
-            std::sort(symbols.begin(), symbols.end());
-            comma = false;
-            std::optional<std::pair<Clingo::Symbol, bool>> objective;
-            for (auto const &sym : symbols) {
-                if (sym.match("__lpx", 2) && sym.arguments().back().type() == Clingo::SymbolType::String) {
+                out_.append("],\"values\":{");
+                for (size_t i = 0; i != size; ++i) {
+                    if (i > 0) {
+                        out_.push_back(',');
+                    }
+                    out_.append(name_(indices[i])); // NOLINT
+                    out_.append(":\"");
+                    append_value_(thread_id, indices[i], values_[i]); // NOLINT
+                    out_.push_back('"');
+                }
+                out_.push_back('}');
+                if (has_objective) {
+                    out_.append(",\"objective\":{\"value\":\"");
+                    out_.append(Clingo::Symbol{objective.symbol}.string()); // NOLINT
+                    out_.append(bounded ? "\",\"bounded\":true}" : "\",\"bounded\":false}");
+                }
+                out_.push_back('}');
+            } else {
+                bool comma = false;
+                for (auto const &sym : symbols) {
                     if (comma) {
-                        std::cout << " ";
+                        out_.push_back(' ');
                     }
-                    auto args = sym.arguments();
-                    std::cout << args.front() << "=" << args.back().string();
+                    out_.append(sym.to_string());
                     comma = true;
-                } else if (sym.match("__lpx_objective", 2) &&
-                           sym.arguments().front().type() == Clingo::SymbolType::String &&
-                           sym.arguments().back().type() == Clingo::SymbolType::Number) {
-                    auto args = sym.arguments();
-                    objective = std::make_pair(args.front(), args.back() == Clingo::Number(1));
+                }
+                out_.append("\nAssignment:\n");
+                for (size_t i = 0; i != size; ++i) {
+                    if (i > 0) {
+                        out_.push_back(' ');
+                    }
+                    out_.append(name_(indices[i])); // NOLINT
+                    out_.push_back('=');
+                    append_value_(thread_id, indices[i], values_[i]); // NOLINT
+                }
+                if (has_objective) {
+                    out_.append("\nOptimization: ");
+                    out_.append(Clingo::Symbol{objective.symbol}.string()); // NOLINT
+                    out_.append(bounded ? " [bounded]" : " [unbounded]");
                 }
             }
-            if (objective.has_value()) {
-                std::cout << "\nOptimization: " << objective->first.string() << " ["
-                          << (objective->second ? "bounded" : "unbounded") << "]";
-            }
-            std::cout << std::endl;
+            out_.push_back('\n');
+            std::cout.write(out_.data(), static_cast<std::streamsize>(out_.size()));
+            std::cout.flush();
         } catch (...) {
         }
     }
@@ -132,12 +252,59 @@ class App : public Clingo::Application, private Clingo::SolveEventHandler {
     //! Register options of the theory and optimization related options.
     void register_options(Clingo::ClingoOptions &options) override {
         handle_error(clingolpx_register_options(theory_, options.to_c()));
+        options.add(
+            "Clingo.LPX Options", "print-format", "Choose how models are printed",
+            [this](char const *value) {
+                if (std::strcmp(value, "text") == 0 || std::strcmp(value, "json") == 0) {
+                    json_ = std::strcmp(value, "json") == 0;
+                    return true;
+                }
+                return false;
+            },
+            false, "{text,json}");
     }
     //! Validate options of the theory.
     void validate_options() override { handle_error(clingolpx_validate_options(theory_)); }
 
   private:
-    clingolpx_theory_t *theory_{nullptr}; //!< The underlying DL theory.
+    //! Get the printed name of the variable at the given index.
+    //!
+    //! Names are cached because variables keep their indices.
+    auto name_(size_t index) -> std::string const & {
+        if (index > names_.size()) {
+            names_.resize(index);
+        }
+        auto &name = names_[index - 1];
+        if (name.empty()) {
+            auto str = Clingo::Symbol{clingolpx_get_symbol(theory_, index)}.to_string();
+            if (json_) {
+                append_json_string(name, str);
+            } else {
+                name = std::move(str);
+            }
+        }
+        return name;
+    }
+
+    //! Append the value of the variable at the given index.
+    //!
+    //! Values whose components do not fit into 64 bit integers are obtained
+    //! as symbols.
+    void append_value_(uint32_t thread_id, size_t index, clingolpx_rational_t const &value) {
+        if (value.denominator != 0) {
+            append_rational(out_, value);
+            return;
+        }
+        clingolpx_value_t symbol{};
+        clingolpx_assignment_get_value(theory_, thread_id, index, &symbol);
+        out_.append(Clingo::Symbol{symbol.symbol}.string()); // NOLINT
+    }
+
+    clingolpx_theory_t *theory_{nullptr};      //!< The underlying DL theory.
+    std::vector<clingolpx_rational_t> values_; //!< Buffer for the values of a model.
+    std::vector<std::string> names_;           //!< Cached names of variables.
+    std::string out_;                          //!< Buffer for the output of a model.
+    bool json_{false};                         //!< Whether to print models as JSON lines.
 };
 
 } // namespace ClingoLPX
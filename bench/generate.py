@@ -0,0 +1,187 @@
+#!/usr/bin/env python
+'''
+Generate scalable benchmark instances for clingo-lpx.
+
+The following families are supported:
+
+- jobshop: job-shop problems using the encoding in examples/encoding-lp.lp,
+- lp: random sparse linear problems with disjunctive constraints,
+- dl: chains of difference constraints with a fixed total length, and
+- lp-strict, dl-strict: variants of lp and dl using strict constraints.
+
+Each generated instance is satisfiable by construction. Instances of strict
+families start with the comment `% requires: strict`, which tells the runner
+to only run them with option `--strict`.
+'''
+
+import argparse
+import os
+import random
+from typing import List, Sequence, Tuple
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+ENCODING = os.path.join(ROOT, 'examples', 'encoding-lp.lp')
+
+FAMILIES = ('jobshop', 'lp', 'dl', 'lp-strict', 'dl-strict')
+
+DEFAULT_SIZES = {
+    'jobshop': ['4x4', '6x6', '8x8', '10x10'],
+    'lp': ['20', '40', '80', '160'],
+    'dl': ['20', '40', '80', '160'],
+}
+
+
+def term(coefficient: int, variable: str) -> str:
+    '''
+    Format a term of a linear constraint.
+    '''
+    if coefficient == 1:
+        return variable
+    if coefficient == -1:
+        return f'-{variable}'
+    return f'{coefficient}*{variable}'
+
+
+def jobshop(rnd: random.Random, size: str, tightness: float) -> str:
+    '''
+    Generate a job-shop problem with the given number of jobs and machines.
+
+    The bound on the start times is the latest start time of a greedy
+    schedule scaled by the given tightness. Hence, instances with tightness
+    1 are satisfiable.
+    '''
+    jobs, machines = (int(x) for x in size.split('x'))
+    lines = []
+    job_ready = [0] * jobs
+    machine_ready = [0] * machines
+    latest = 0
+    for job in range(jobs):
+        order = list(range(machines))
+        rnd.shuffle(order)
+        for task, machine in enumerate(order):
+            duration = rnd.randint(1, 99)
+            lines.append(f'executionTime({job + 1},{task + 1},{duration}).')
+            lines.append(f'assign({job + 1},{task + 1},{machine + 1}).')
+            start = max(job_ready[job], machine_ready[machine])
+            latest = max(latest, start)
+            job_ready[job] = machine_ready[machine] = start + duration
+    lines.append(f'bound({int(latest * tightness)}).')
+    with open(ENCODING) as fh:
+        encoding = fh.read()
+    return encoding + '\n' + '\n'.join(lines) + '\n'
+
+
+def sparse_lp(rnd: random.Random, size: str, strict: bool) -> str:
+    '''
+    Generate a random sparse problem with the given number of variables.
+
+    There is one constraint per variable with three non-zero coefficients.
+    A choice determines whether its left-hand side is below or above the
+    right-hand side. The right-hand sides are chosen around the values of a
+    random point, which satisfies one of the two alternatives.
+    '''
+    n = int(size)
+    point = [rnd.randint(-50, 50) for _ in range(n)]
+    lines = []
+    for j in range(n):
+        lines.append(f'&sum {{ x({j + 1}) }} >= -100.')
+        lines.append(f'&sum {{ x({j + 1}) }} <= 100.')
+    for i in range(n):
+        variables = rnd.sample(range(n), min(3, n))
+        coefficients = [rnd.choice([-1, 1]) * rnd.randint(1, 9) for _ in variables]
+        value = sum(c * point[j] for c, j in zip(coefficients, variables))
+        lhs = '; '.join(term(c, f'x({j + 1})') for c, j in zip(coefficients, variables))
+        lines.append(f'{{ c({i + 1}) }}.')
+        if strict:
+            rhs = value + rnd.choice([-1, 1]) * rnd.randint(1, 5)
+            lines.append(f'&sum {{ {lhs} }} < {rhs} :- c({i + 1}).')
+            lines.append(f'&sum {{ {lhs} }} > {rhs} :- not c({i + 1}).')
+        else:
+            rhs = value + rnd.randint(-5, 5)
+            lines.append(f'&sum {{ {lhs} }} <= {rhs} :- c({i + 1}).')
+            lines.append(f'&sum {{ {lhs} }} >= {rhs + 1} :- not c({i + 1}).')
+    return '\n'.join(lines) + '\n'
+
+
+def dl_chain(rnd: random.Random, size: str, strict: bool, window: int = 2) -> str:
+    '''
+    Generate a chain of difference constraints with the given length.
+
+    A choice determines whether a link in the chain moves forward or
+    backward by (about) its length. The total length of the chain is fixed
+    to the one of a random choice of directions.
+    '''
+    n = int(size)
+    rel, adjust = ('<', 1) if strict else ('<=', 0)
+    lines = []
+    total = 0
+    for i in range(n):
+        length = rnd.randint(1, 20)
+        total += rnd.choice([-1, 1]) * length
+        lines.append(f'{{ e({i}) }}.')
+        lines.append(f'&diff {{ x({i}) - x({i + 1}) }} {rel} {-length + adjust} :- e({i}).')
+        lines.append(f'&diff {{ x({i + 1}) - x({i}) }} {rel} {length + window + adjust} :- e({i}).')
+        lines.append(f'&diff {{ x({i + 1}) - x({i}) }} {rel} {-length + adjust} :- not e({i}).')
+        lines.append(f'&diff {{ x({i}) - x({i + 1}) }} {rel} {length + window + adjust} :- not e({i}).')
+    lines.append(f'&diff {{ x({n}) - x(0) }} = {total}.')
+    return '\n'.join(lines) + '\n'
+
+
+def generate(rnd: random.Random, family: str, size: str, tightness: float) -> str:
+    '''
+    Generate an instance of the given family and size.
+    '''
+    if family == 'jobshop':
+        return jobshop(rnd, size, tightness)
+    strict = family.endswith('-strict')
+    base = family[:-len('-strict')] if strict else family
+    text = sparse_lp(rnd, size, strict) if base == 'lp' else dl_chain(rnd, size, strict)
+    return ('% requires: strict\n' + text) if strict else text
+
+
+def parse_families(args: argparse.Namespace) -> List[Tuple[str, Sequence[str]]]:
+    '''
+    Get the families to generate together with their sizes.
+    '''
+    result = []
+    for family in args.families:
+        base = family[:-len('-strict')] if family.endswith('-strict') else family
+        sizes = getattr(args, f'{base}_sizes') or DEFAULT_SIZES[base]
+        result.append((family, sizes))
+    return result
+
+
+def main():
+    '''
+    Parse the command line and write the instances.
+    '''
+    parser = argparse.ArgumentParser(description='Generate benchmark instances for clingo-lpx.')
+    parser.add_argument('output', help='directory to write instances to (one subdirectory per family)')
+    parser.add_argument('--families', nargs='+', choices=FAMILIES, default=list(FAMILIES),
+                        help='families to generate (default: all)')
+    parser.add_argument('--jobshop-sizes', nargs='+', metavar='JOBSxMACHINES',
+                        help=f'sizes of job-shop instances (default: {" ".join(DEFAULT_SIZES["jobshop"])})')
+    parser.add_argument('--lp-sizes', nargs='+', metavar='N',
+                        help=f'number of variables of lp instances (default: {" ".join(DEFAULT_SIZES["lp"])})')
+    parser.add_argument('--dl-sizes', nargs='+', metavar='N',
+                        help=f'length of dl chains (default: {" ".join(DEFAULT_SIZES["dl"])})')
+    parser.add_argument('--instances', type=int, default=3, help='number of instances per size (default: 3)')
+    parser.add_argument('--tightness', type=float, default=1.0,
+                        help='factor to scale the bound of job-shop instances with (default: 1.0)')
+    parser.add_argument('--seed', type=int, default=0, help='random seed (default: 0)')
+    args = parser.parse_args()
+
+    for family, sizes in parse_families(args):
+        path = os.path.join(args.output, family)
+        os.makedirs(path, exist_ok=True)
+        for size in sizes:
+            for k in range(args.instances):
+                # seed each instance separately so that instances do not
+                # depend on the selected families and sizes
+                rnd = random.Random(f'{args.seed}-{family}-{size}-{k}')
+                with open(os.path.join(path, f'{family}-{size}-{k + 1}.lp'), 'w') as fh:
+                    fh.write(generate(rnd, family, size, args.tightness))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,189 @@
+#!/usr/bin/env python
+'''
+Run clingo-lpx on benchmark instances over a matrix of configurations.
+
+For each instance, configuration, and repetition, one row is appended to a
+CSV file holding the solving time and pivots reported by clingo-lpx, the
+wall-clock time, and the peak resident set size of the process. Rows are
+written as soon as a run finishes; existing rows are kept and runs already
+in the file are skipped, which allows for resuming interrupted runs.
+
+Measuring the peak resident set size requires a POSIX system.
+'''
+
+import argparse
+import csv
+import itertools
+import os
+import re
+import shlex
+import subprocess
+import sys
+import tempfile
+import time
+from typing import Dict, Iterator, List, Optional, Sequence, Tuple
+
+FIELDS = ['version', 'family', 'instance', 'propagate_bounds', 'select', 'store', 'strict', 'threads', 'run',
+          'status', 'exit_code', 'time', 'wall', 'pivots', 'rss_kb']
+
+KEY_FIELDS = FIELDS[:9]
+
+STATUS = ('OPTIMUM FOUND', 'UNSATISFIABLE', 'SATISFIABLE', 'UNKNOWN')
+
+
+def split_list(value: str) -> List[str]:
+    '''
+    Split a comma-separated list.
+    '''
+    return [x for x in value.split(',') if x]
+
+
+def collect(paths: Sequence[str]) -> Iterator[str]:
+    '''
+    Collect the instances in the given files and directories.
+    '''
+    for path in paths:
+        if os.path.isdir(path):
+            for root, dirnames, filenames in os.walk(path):
+                dirnames.sort()
+                for filename in sorted(filenames):
+                    if filename.endswith('.lp'):
+                        yield os.path.join(root, filename)
+        else:
+            yield path
+
+
+def requires_strict(instance: str) -> bool:
+    '''
+    Check whether the instance has to be solved with option `--strict`.
+    '''
+    with open(instance) as fh:
+        for line in fh:
+            if not line.startswith('%'):
+                break
+            if re.match(r'%\s*requires:.*\bstrict\b', line):
+                return True
+    return False
+
+
+def version(binary: str) -> str:
+    '''
+    Get the version of clingo-lpx.
+    '''
+    out = subprocess.run([binary, '--version'], stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                         universal_newlines=True, check=False).stdout
+    match = re.search(r'clingo-lpx version (\S+)', out)
+    return match.group(1) if match else 'unknown'
+
+
+def parse_output(out: str) -> Dict[str, str]:
+    '''
+    Extract status, solving time, and pivots from the output of clingo-lpx.
+    '''
+    result = {'status': 'ERROR', 'time': '', 'pivots': ''}
+    for status in STATUS:
+        if re.search(rf'^{status}$', out, re.MULTILINE):
+            result['status'] = status
+            break
+    match = re.search(r'^Time\s*:\s*([0-9.]+)s', out, re.MULTILINE)
+    if match:
+        result['time'] = match.group(1)
+    # the accumulated pivots are printed last
+    pivots = re.findall(r'^\s*Pivots\s*:\s*([0-9]+)', out, re.MULTILINE)
+    if pivots:
+        result['pivots'] = pivots[-1]
+    return result
+
+
+def execute(cmd: List[str]) -> Tuple[str, int, float, Optional[int]]:
+    '''
+    Execute the given command returning its output, exit code, wall-clock
+    time, and peak resident set size in kilobytes.
+    '''
+    with tempfile.TemporaryFile(mode='w+') as out:
+        start = time.perf_counter()
+        proc = subprocess.Popen(cmd, stdout=out, stderr=subprocess.STDOUT, universal_newlines=True)
+        if hasattr(os, 'wait4'):
+            _, status, usage = os.wait4(proc.pid, 0)
+            proc.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -os.WTERMSIG(status)
+            # ru_maxrss is given in bytes on macOS and in kilobytes elsewhere
+            rss = usage.ru_maxrss // 1024 if sys.platform == 'darwin' else usage.ru_maxrss
+        else:
+            proc.wait()
+            rss = None
+        wall = time.perf_counter() - start
+        out.seek(0)
+        return out.read(), proc.returncode, wall, rss
+
+
+def load(path: str) -> set:
+    '''
+    Load the keys of runs already in the given CSV file.
+    '''
+    if not os.path.exists(path):
+        return set()
+    with open(path, newline='') as fh:
+        return {tuple(row[x] for x in KEY_FIELDS) for row in csv.DictReader(fh)}
+
+
+def main():
+    '''
+    Parse the command line and run the benchmarks.
+    '''
+    parser = argparse.ArgumentParser(description='Run clingo-lpx over a matrix of configurations.')
+    parser.add_argument('instances', nargs='+', help='instance files or directories (searched for *.lp files)')
+    parser.add_argument('--binary', default='clingo-lpx', help='clingo-lpx executable (default: clingo-lpx)')
+    parser.add_argument('--output', default='results.csv', help='CSV file to append to (default: results.csv)')
+    parser.add_argument('--propagate-bounds', type=split_list, default=['none', 'changed', 'full'],
+                        help='comma-separated values of --propagate-bounds (default: none,changed,full)')
+    parser.add_argument('--select', type=split_list, default=['none', 'match', 'conflict'],
+                        help='comma-separated values of --select (default: none,match,conflict)')
+    parser.add_argument('--store', type=split_list, default=['no', 'partial', 'total'],
+                        help='comma-separated values of --store (default: no,partial,total)')
+    parser.add_argument('--strict', type=split_list, default=['no', 'yes'],
+                        help='comma-separated values whether to pass --strict (default: no,yes)')
+    parser.add_argument('--threads', type=split_list, default=['1', '4'],
+                        help='comma-separated numbers of threads (default: 1,4)')
+    parser.add_argument('--runs', type=int, default=1, help='number of runs per configuration (default: 1)')
+    parser.add_argument('--timeout', type=int, default=300, help='time limit in seconds per run (default: 300)')
+    parser.add_argument('--version', dest='label',
+                        help='value of the version column (default: the version reported by the binary)')
+    parser.add_argument('--extra', default='', help='additional arguments passed to clingo-lpx')
+    args = parser.parse_args()
+    extra = shlex.split(args.extra)
+
+    label = args.label or version(args.binary)
+    done = load(args.output)
+    exists = os.path.exists(args.output) and os.path.getsize(args.output) > 0
+    matrix = list(itertools.product(args.propagate_bounds, args.select, args.store, args.strict, args.threads))
+
+    with open(args.output, 'a', newline='') as fh:
+        writer = csv.DictWriter(fh, fieldnames=FIELDS)
+        if not exists:
+            writer.writeheader()
+        for instance in collect(args.instances):
+            strict_only = requires_strict(instance)
+            family = os.path.basename(os.path.dirname(os.path.abspath(instance)))
+            for (propagate, select, store, strict, threads), run in itertools.product(matrix, range(args.runs)):
+                if strict_only and strict != 'yes':
+                    continue
+                row = {'version': label, 'family': family, 'instance': instance, 'propagate_bounds': propagate,
+                       'select': select, 'store': store, 'strict': strict, 'threads': threads, 'run': str(run + 1)}
+                if tuple(row[x] for x in KEY_FIELDS) in done:
+                    continue
+                cmd = [args.binary, instance, '--stats', '-q', f'--time-limit={args.timeout}',
+                       f'--propagate-bounds={propagate}', f'--select={select}', f'--store={store}',
+                       f'--parallel-mode={threads}']
+                if strict == 'yes':
+                    cmd.append('--strict')
+                out, code, wall, rss = execute(cmd + extra)
+                row.update(parse_output(out))
+                row.update({'exit_code': code, 'wall': f'{wall:.3f}', 'rss_kb': '' if rss is None else rss})
+                writer.writerow(row)
+                fh.flush()
+                print(f'{row["status"]:>13} {row["wall"]:>9}s {instance} '
+                      f'{propagate} {select} {store} {strict} {threads}', flush=True)
+
+
+if __name__ == '__main__':
+    main()
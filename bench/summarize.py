@@ -0,0 +1,121 @@
+#!/usr/bin/env python
+'''
+Summarize benchmark results written by run.py.
+
+Runs are grouped by version and configuration. For each group, the number
+of solved runs, the PAR-2 score, the total number of pivots, and the maximum
+peak resident set size are reported. Unsolved runs count twice the time
+limit in the PAR-2 score.
+
+When comparing two versions, instances and configurations that have not
+been run with both versions are ignored and the ratios of the scores of the
+second version over the ones of the first version are reported. Ratios
+above the given threshold are marked as regressions.
+'''
+
+import argparse
+import csv
+from collections import defaultdict
+from typing import Dict, List, Tuple
+
+CONFIG = ('family', 'propagate_bounds', 'select', 'store', 'strict', 'threads')
+
+SOLVED = ('SATISFIABLE', 'UNSATISFIABLE', 'OPTIMUM FOUND')
+
+Score = Dict[str, float]
+
+
+def load(paths: List[str]) -> List[Dict[str, str]]:
+    '''
+    Load the rows of the given CSV files.
+    '''
+    rows = []
+    for path in paths:
+        with open(path, newline='') as fh:
+            rows.extend(csv.DictReader(fh))
+    return rows
+
+
+def score(rows: List[Dict[str, str]], timeout: float) -> Score:
+    '''
+    Compute the scores of the given runs.
+    '''
+    solved = [row for row in rows if row['status'] in SOLVED]
+    return {'runs': len(rows),
+            'solved': len(solved),
+            'par2': sum(float(row['time'] or timeout) for row in solved) + 2 * timeout * (len(rows) - len(solved)),
+            'pivots': sum(int(row['pivots'] or 0) for row in rows),
+            'rss_kb': max((int(row['rss_kb'] or 0) for row in rows), default=0)}
+
+
+def group(rows: List[Dict[str, str]]) -> Dict[Tuple[str, ...], List[Dict[str, str]]]:
+    '''
+    Group rows by configuration.
+    '''
+    groups = defaultdict(list)
+    for row in rows:
+        groups[tuple(row[x] for x in CONFIG)].append(row)
+    return groups
+
+
+def ratio(new: float, old: float) -> float:
+    '''
+    Compute the ratio of two scores.
+    '''
+    return new / old if old > 0 else (1.0 if new == 0 else float('inf'))
+
+
+def main():
+    '''
+    Parse the command line and print the summary.
+    '''
+    parser = argparse.ArgumentParser(description='Summarize benchmark results of clingo-lpx.')
+    parser.add_argument('results', nargs='+', help='CSV files written by run.py')
+    parser.add_argument('--timeout', type=float, default=300, help='time limit used for the runs (default: 300)')
+    parser.add_argument('--compare', nargs=2, metavar=('OLD', 'NEW'), help='compare two versions')
+    parser.add_argument('--threshold', type=float, default=1.1,
+                        help='ratio above which a comparison is marked as regression (default: 1.1)')
+    args = parser.parse_args()
+
+    rows = load(args.results)
+    header = ' '.join(f'{x:>16}' for x in CONFIG)
+
+    if args.compare is None:
+        by_version = defaultdict(list)
+        for row in rows:
+            by_version[row['version']].append(row)
+        for version, version_rows in sorted(by_version.items()):
+            print(f'version {version}')
+            print(f'{header} {"solved":>9} {"par2":>10} {"pivots":>12} {"rss_kb":>10}')
+            scores = [(config, score(config_rows, args.timeout)) for config, config_rows in group(version_rows).items()]
+            # best configurations first
+            scores.sort(key=lambda x: (x[0][0], -x[1]['solved'], x[1]['par2']))
+            for config, s in scores:
+                print(f'{" ".join(f"{x:>16}" for x in config)} {s["solved"]:>4}/{s["runs"]:<4} '
+                      f'{s["par2"]:>10.2f} {s["pivots"]:>12} {s["rss_kb"]:>10}')
+            print()
+        return
+
+    old, new = args.compare
+    runs = defaultdict(dict)
+    for row in rows:
+        if row['version'] in (old, new):
+            key = tuple(row[x] for x in CONFIG) + (row['instance'], row['run'])
+            runs[key][row['version']] = row
+    common = [x for x in runs.values() if old in x and new in x]
+    regressions = 0
+    print(f'{header} {"par2":>8} {"pivots":>8} {"rss_kb":>8}')
+    for config, pairs in sorted(group([x[old] for x in common]).items()):
+        s_old = score(pairs, args.timeout)
+        s_new = score([runs[config + (x['instance'], x['run'])][new] for x in pairs], args.timeout)
+        ratios = [ratio(s_new[x], s_old[x]) for x in ('par2', 'pivots', 'rss_kb')]
+        mark = ''
+        if any(x > args.threshold for x in ratios):
+            regressions += 1
+            mark = ' regression'
+        print(f'{" ".join(f"{x:>16}" for x in config)} {" ".join(f"{x:>8.3f}" for x in ratios)}{mark}')
+    print(f'\n{regressions} regression(s) in {len(common)} common runs')
+
+
+if __name__ == '__main__':
+    main()
@@ -83,6 +83,27 @@ typedef struct clingolpx_value {
     };
 } clingolpx_value_t;
 
+//! the value numerator/denominator + epsilon_numerator/epsilon_denominator * e
+//! the epsilon component is only non-zero in strict mode
+//! denominators are positive and fractions are in canonical form
+//! the denominator is zero if a component does not fit into 64 bit integers
+typedef struct clingolpx_rational {
+    int64_t numerator;
+    int64_t denominator;
+    int64_t epsilon_numerator;
+    int64_t epsilon_denominator;
+} clingolpx_rational_t;
+
+//! the relation of a constraint (see ::clingolpx_add_constraint)
+enum clingolpx_relation {
+    clingolpx_relation_less_equal = 0,
+    clingolpx_relation_greater_equal = 1,
+    clingolpx_relation_equal = 2,
+    clingolpx_relation_less = 3,
+    clingolpx_relation_greater = 4
+};
+typedef int clingolpx_relation_t;
+
 //! Callback to rewrite statements (see ::clingolpx_rewrite_ast).
 typedef bool (*clingolpx_ast_callback_t)(clingo_ast_t *ast, void *data);
 
@@ -120,6 +141,19 @@ CLINGOLPX_VISIBILITY_DEFAULT bool clingolpx_validate_options(clingolpx_theory_t
 //! callback on every model
 CLINGOLPX_VISIBILITY_DEFAULT bool clingolpx_on_model(clingolpx_theory_t *theory, clingo_model_t *model);
 
+//! add the constraint sum_i numerators[i]/denominators[i] * variables[i] <relation> rhs_numerator/rhs_denominator
+//! the constraint is guarded by the given program literal, e.g., obtained from the backend
+//! the denominators can be NULL in which case all denominators are 1
+//! variables must not be numbers, which are reserved for auxiliary variables
+//! strict relations require option strict
+//! the constraint is passed to the solvers at the beginning of the next solve call
+//! the theory has to be registered before adding constraints
+CLINGOLPX_VISIBILITY_DEFAULT bool clingolpx_add_constraint(clingolpx_theory_t *theory, clingo_literal_t literal,
+                                                           clingo_symbol_t const *variables, int64_t const *numerators,
+                                                           int64_t const *denominators, size_t size,
+                                                           clingolpx_relation_t relation, int64_t rhs_numerator,
+                                                           int64_t rhs_denominator);
+
 //! obtain a symbol index which can be used to get the value of a symbol
 //! returns true if the symbol exists
 //! does not throw
@@ -151,6 +185,42 @@ CLINGOLPX_VISIBILITY_DEFAULT bool clingolpx_assignment_has_value(clingolpx_theor
 CLINGOLPX_VISIBILITY_DEFAULT void clingolpx_assignment_get_value(clingolpx_theory_t *theory, uint32_t thread_id,
                                                                  size_t index, clingolpx_value_t *value);
 
+//! get the values of the symbols at the given indices as rationals
+//! values that do not fit have denominator zero and can be obtained with ::clingolpx_assignment_get_value
+//! if indices is NULL, the values at indices 1 to size are stored
+//! all indices must have values (see ::clingolpx_assignment_has_value)
+CLINGOLPX_VISIBILITY_DEFAULT bool clingolpx_assignment_get_values(clingolpx_theory_t *theory, uint32_t thread_id,
+                                                                  size_t const *indices, size_t size,
+                                                                  clingolpx_rational_t *values);
+
+//! get the number of indices in the assignment of a thread
+//! valid indices range from 1 to the returned size
+//! does not throw
+CLINGOLPX_VISIBILITY_DEFAULT size_t clingolpx_assignment_size(clingolpx_theory_t *theory, uint32_t thread_id);
+
+//! store the values at indices 1 to size in the given arrays, which can be NULL if not needed
+//! the rational components are stored as fractions numerators[i]/denominators[i] and as doubles
+//! the epsilon components are ignored (see ::clingolpx_assignment_get_values)
+//! the values include the ones of auxiliary variables, whose symbols are numbers
+//! fails if size exceeds ::clingolpx_assignment_size or
+//! if numerators or denominators are requested and a fraction does not fit into 64 bit integers
+CLINGOLPX_VISIBILITY_DEFAULT bool clingolpx_assignment_get_arrays(clingolpx_theory_t *theory, uint32_t thread_id,
+                                                                  size_t size, int64_t *numerators,
+                                                                  int64_t *denominators, double *doubles);
+
+//! get the indices of variables whose values are shown in increasing order
+//! the shown variables can be restricted with option show-values
+//! the indices stay valid until the next call to a function of the theory
+CLINGOLPX_VISIBILITY_DEFAULT bool clingolpx_assignment_get_shown(clingolpx_theory_t *theory, uint32_t thread_id,
+                                                                 size_t const **indices, size_t *size);
+
+//! get the value of the objective function and whether it is bounded
+//! has_objective is set to false if there is no objective function
+//! the value is stored as a symbol like by ::clingolpx_assignment_get_value
+CLINGOLPX_VISIBILITY_DEFAULT bool clingolpx_assignment_get_objective(clingolpx_theory_t *theory, uint32_t thread_id,
+                                                                     bool *has_objective, clingolpx_value_t *value,
+                                                                     bool *bounded);
+
 //! callback on statistic updates
 /// please add a subkey with the name of your theory
 CLINGOLPX_VISIBILITY_DEFAULT bool clingolpx_on_statistics(clingolpx_theory_t *theory, clingo_statistics_t *step,
@@ -29,9 +29,12 @@
 #include <clingo.h>
 #include <clingo.hh>
 
+#include <algorithm>
+#include <limits>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 
 #define CLINGOLPX_TRY try // NOLINT
 #define CLINGOLPX_CATCH                                                                                                \
@@ -46,51 +49,65 @@ namespace {
 using Clingo::Detail::handle_error;
 
 //! C initialization callback for the LPX propagator.
-template <typename Value> auto init(clingo_propagate_init_t *i, void *data) -> bool {
+template <typename Value, typename Matrix> auto init(clingo_propagate_init_t *i, void *data) -> bool {
     CLINGOLPX_TRY {
         Clingo::PropagateInit in(i);
-        static_cast<Propagator<Value> *>(data)->init(in);
+        static_cast<Propagator<Value, Matrix> *>(data)->init(in);
     }
     CLINGOLPX_CATCH;
 }
 
 //! C propagation callback for the LPX propagator.
-template <typename Value>
+template <typename Value, typename Matrix>
 auto propagate(clingo_propagate_control_t *i, const clingo_literal_t *changes, size_t size, void *data) -> bool {
     CLINGOLPX_TRY {
         Clingo::PropagateControl in(i);
-        static_cast<Propagator<Value> *>(data)->propagate(in, {changes, size});
+        static_cast<Propagator<Value, Matrix> *>(data)->propagate(in, {changes, size});
     }
     CLINGOLPX_CATCH;
 }
 
 //! C undo callback for the LPX propagator.
-template <typename Value>
+template <typename Value, typename Matrix>
 void undo(clingo_propagate_control_t const *i, const clingo_literal_t *changes, size_t size, void *data) {
     Clingo::PropagateControl in(const_cast<clingo_propagate_control_t *>(i)); // NOLINT
-    static_cast<Propagator<Value> *>(data)->undo(in, {changes, size});
+    static_cast<Propagator<Value, Matrix> *>(data)->undo(in, {changes, size});
 }
 
 //! C check callback for the LPX propagator.
-template <typename Value> auto check(clingo_propagate_control_t *i, void *data) -> bool {
+template <typename Value, typename Matrix> auto check(clingo_propagate_control_t *i, void *data) -> bool {
     CLINGOLPX_TRY {
         Clingo::PropagateControl in(i);
-        static_cast<Propagator<Value> *>(data)->check(in);
+        static_cast<Propagator<Value, Matrix> *>(data)->check(in);
     }
     CLINGOLPX_CATCH;
 }
 
 //! C decide callback for the LPX propagator.
-template <typename Value>
+template <typename Value, typename Matrix>
 auto decide(clingo_id_t thread_id, clingo_assignment_t const *assignment, clingo_literal_t fallback, void *data,
             clingo_literal_t *decision) -> bool {
     CLINGOLPX_TRY {
         Clingo::Assignment assign(const_cast<clingo_assignment_t *>(assignment)); // NOLINT
-        *decision = static_cast<Propagator<Value> *>(data)->decide(thread_id, assign, fallback);
+        *decision = static_cast<Propagator<Value, Matrix> *>(data)->decide(thread_id, assign, fallback);
     }
     CLINGOLPX_CATCH;
 }
 
+//! Store the numerator and denominator of a rational in the given integers.
+//!
+//! The function returns false if they do not fit into 64 bit integers.
+auto to_int64(Rational const &x, int64_t &num, int64_t &den) -> bool {
+    auto x_num = x.num().as_int64();
+    auto x_den = x.den().as_int64();
+    if (!x_num.has_value() || !x_den.has_value()) {
+        return false;
+    }
+    num = *x_num;
+    den = *x_den;
+    return true;
+}
+
 //! High level interface to use the LPX propagator hiding the value type.
 class PropagatorFacade {
   public:
@@ -101,6 +118,8 @@ class PropagatorFacade {
     auto operator=(PropagatorFacade &&other) noexcept -> PropagatorFacade & = default;
     virtual ~PropagatorFacade() = default;
 
+    //! Add an inequality guarded by a program literal.
+    virtual void add_inequality(Inequality iq) = 0;
     //! Look up the index of a symbol.
     //!
     //! The function returns false if the symbol could not be found.
@@ -111,32 +130,63 @@ class PropagatorFacade {
     virtual auto has_value(uint32_t thread_id, size_t index) -> bool = 0;
     //! Get the value of a symbol in a thread.
     virtual void get_value(uint32_t thread_id, size_t index, clingolpx_value_t *value) = 0;
+    //! Get the values of the symbols at the given indices in a thread as
+    //! rationals.
+    //!
+    //! If indices is a null pointer, the values at indices 1 to size are
+    //! obtained.
+    virtual void get_values(uint32_t thread_id, size_t const *indices, size_t size, clingolpx_rational_t *values) = 0;
+    //! Get the number of indices in the assignment of a thread.
+    virtual auto n_values(uint32_t thread_id) -> size_t = 0;
+    //! Store the rational components of the values at indices 1 to size in
+    //! the given arrays.
+    //!
+    //! Arrays that are null pointers are skipped.
+    virtual void get_arrays(uint32_t thread_id, size_t size, int64_t *numerators, int64_t *denominators,
+                            double *doubles) = 0;
     //! Function to iterate over the thread specific assignment of symbols and values.
     //!
     //! Argument current should initially be set to 0. The function returns
     //! false if no more values are available.
     virtual auto next(uint32_t thread_id, size_t *current) -> bool = 0;
+    //! Get the indices of variables whose values are added to models in
+    //! increasing order.
+    //!
+    //! The indices stay valid until the next call of a function of the
+    //! facade.
+    virtual void get_shown(uint32_t thread_id, size_t const **indices, size_t *size) = 0;
+    //! Get the objective value in a thread and whether it is bounded.
+    //!
+    //! The function returns false if there is no objective.
+    virtual auto get_objective(uint32_t thread_id, clingolpx_value_t *value, bool *bounded) -> bool = 0;
     //! Extend the given model with the assignment stored in the propagator.
     virtual void extend_model(Clingo::Model &m) = 0;
     //! Add the propagator statistics to clingo's statistics.
     virtual void on_statistics(Clingo::UserStatistics &step, Clingo::UserStatistics &accu) = 0;
+    //! Write the recorded trace events and close the recording (if
+    //! enabled).
+    virtual void finish() = 0;
 };
 
 //! High level interface to use the LPX propagator.
-template <typename Value> class LPXPropagatorFacade : public PropagatorFacade {
+template <typename Value, typename Matrix> class LPXPropagatorFacade : public PropagatorFacade {
   public:
-    LPXPropagatorFacade(clingo_control_t *control, char const *theory, Options const &options) : prop_{options} {
+    LPXPropagatorFacade(clingo_control_t *control, char const *theory, Options const &options)
+        : prop_{options}, show_values_{options.show_values}, extend_model_{options.extend_model} {
         handle_error(clingo_control_add(control, "base", nullptr, 0, theory));
         static clingo_propagator_t prp = {
-            init<Value>, propagate<Value>, undo<Value>, check<Value>, decide<Value>,
+            init<Value, Matrix>, propagate<Value, Matrix>, undo<Value, Matrix>, check<Value, Matrix>,
+            decide<Value, Matrix>,
         };
         static clingo_propagator_t heu = {
-            init<Value>, propagate<Value>, undo<Value>, check<Value>, nullptr,
+            init<Value, Matrix>, propagate<Value, Matrix>, undo<Value, Matrix>, check<Value, Matrix>, nullptr,
         };
-        handle_error(clingo_control_register_propagator(
-            control, options.select != SelectionHeuristic::None ? &prp : &heu, &prop_, false));
+        bool heuristic = options.select != SelectionHeuristic::None || options.portfolio != Portfolio::None;
+        handle_error(clingo_control_register_propagator(control, heuristic ? &prp : &heu, &prop_, false));
     }
 
+    void add_inequality(Inequality iq) override { prop_.add_inequality(std::move(iq)); }
+
     auto lookup_symbol(clingo_symbol_t name, size_t *index) -> bool override {
         if (auto ret = prop_.lookup_symbol(Clingo::Symbol{name}); ret) {
             *index = *ret + 1;
@@ -152,10 +202,51 @@ template <typename Value> class LPXPropagatorFacade : public PropagatorFacade {
     }
 
     void get_value(uint32_t thread_id, size_t index, clingolpx_value_t *value) override {
-        ss_.str("");
-        ss_ << prop_.get_value(thread_id, index - 1);
-        value->type = clingolpx_value_type_symbol;
-        value->symbol = Clingo::String(ss_.str().c_str()).to_c(); // NOLINT
+        store_symbol_(prop_.get_value(thread_id, index - 1), value);
+    }
+
+    void get_values(uint32_t thread_id, size_t const *indices, size_t size, clingolpx_rational_t *values) override {
+        for (size_t i = 0; i != size; ++i) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            auto index = indices != nullptr ? indices[i] : i + 1;
+            store_rational_(prop_.get_value(thread_id, index - 1), values[i]); // NOLINT
+        }
+    }
+
+    auto n_values(uint32_t thread_id) -> size_t override { return prop_.n_values(thread_id); }
+
+    void get_arrays(uint32_t thread_id, size_t size, int64_t *numerators, int64_t *denominators,
+                    double *doubles) override {
+        if (size > prop_.n_values(thread_id)) {
+            throw std::invalid_argument("size exceeds the number of values");
+        }
+        int64_t num = 0;
+        int64_t den = 1;
+        for (size_t i = 0; i != size; ++i) {
+            auto value = prop_.get_value(thread_id, i);
+            Rational const *real = nullptr;
+            if constexpr (std::is_same_v<Value, RationalQ>) {
+                real = &value.c();
+            } else {
+                real = &value;
+            }
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            if (numerators != nullptr || denominators != nullptr) {
+                if (!to_int64(*real, num, den)) {
+                    throw std::overflow_error("value does not fit into 64 bit integers");
+                }
+                if (numerators != nullptr) {
+                    numerators[i] = num;
+                }
+                if (denominators != nullptr) {
+                    denominators[i] = den;
+                }
+            }
+            if (doubles != nullptr) {
+                doubles[i] = real->as_double();
+            }
+            // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
     }
 
     auto next(uint32_t thread_id, size_t *current) -> bool override {
@@ -169,10 +260,16 @@ template <typename Value> class LPXPropagatorFacade : public PropagatorFacade {
     }
 
     void extend_model(Clingo::Model &model) override {
+        if (!extend_model_) {
+            prop_.on_model(model);
+            return;
+        }
         std::vector<Clingo::Symbol> symbols;
         auto thread_id = model.thread_id();
 
-        for (size_t i = 0; next(thread_id, &i);) {
+        update_shown_(thread_id);
+        symbols.reserve(shown_.size() + 1);
+        for (auto i : shown_) {
             ss_.str("");
             ss_ << prop_.get_value(thread_id, i - 1);
             symbols.emplace_back(
@@ -189,13 +286,82 @@ template <typename Value> class LPXPropagatorFacade : public PropagatorFacade {
         prop_.on_model(model);
     }
 
+    void get_shown(uint32_t thread_id, size_t const **indices, size_t *size) override {
+        update_shown_(thread_id);
+        *indices = shown_.data();
+        *size = shown_.size();
+    }
+
+    auto get_objective(uint32_t thread_id, clingolpx_value_t *value, bool *bounded) -> bool override {
+        auto objective = prop_.get_objective(thread_id);
+        if (!objective.has_value()) {
+            return false;
+        }
+        store_symbol_(objective->first, value);
+        *bounded = objective->second;
+        return true;
+    }
+
     void on_statistics(Clingo::UserStatistics &step, Clingo::UserStatistics &accu) override {
         prop_.on_statistics(step, accu);
     }
 
+    void finish() override { prop_.finish(); }
+
   private:
-    Propagator<Value> prop_; //!< The underlying LPX propagator.
+    //! Update the indices of variables whose values are added to models.
+    //!
+    //! Variables are only ever appended. Hence, only variables added since
+    //! the last call have to be checked.
+    void update_shown_(uint32_t thread_id) {
+        for (auto n = prop_.n_values(thread_id); n_checked_ < n; ++n_checked_) {
+            auto sym = prop_.get_symbol(n_checked_);
+            if (sym.type() == Clingo::SymbolType::Number) {
+                continue;
+            }
+            if (!show_values_.has_value() ||
+                std::any_of(show_values_->begin(), show_values_->end(),
+                            [&sym](auto const &sig) { return sym.match(sig.first.c_str(), sig.second); })) {
+                shown_.emplace_back(n_checked_ + 1);
+            }
+        }
+    }
+
+    //! Store a value as a string symbol.
+    void store_symbol_(Value const &x, clingolpx_value_t *value) {
+        ss_.str("");
+        ss_ << x;
+        value->type = clingolpx_value_type_symbol;
+        value->symbol = Clingo::String(ss_.str().c_str()).to_c(); // NOLINT
+    }
+
+    //! Store a value as a rational setting the denominator to zero if its
+    //! components do not fit into 64 bit integers.
+    static void store_rational_(Value const &x, clingolpx_rational_t &ret) {
+        bool fits = false;
+        if constexpr (std::is_same_v<Value, RationalQ>) {
+            fits = to_int64(x.c(), ret.numerator, ret.denominator) &&
+                   to_int64(x.k(), ret.epsilon_numerator, ret.epsilon_denominator);
+        } else {
+            fits = to_int64(x, ret.numerator, ret.denominator);
+            ret.epsilon_numerator = 0;
+            ret.epsilon_denominator = 1;
+        }
+        if (!fits) {
+            ret.denominator = 0;
+        }
+    }
+
+    Propagator<Value, Matrix> prop_; //!< The underlying LPX propagator.
     std::ostringstream ss_;
+    //! The names and arities of variables whose values are added to models.
+    std::optional<std::vector<std::pair<std::string, uint32_t>>> show_values_;
+    //! Whether to add the values of shown variables to models.
+    bool extend_model_;
+    //! The indices of variables whose values are added to models.
+    std::vector<size_t> shown_;
+    //! The number of variables checked by update_shown_().
+    index_t n_checked_{0};
 };
 
 //! Check if b is a lower case prefix of a returning a pointer to the remainder of a.
@@ -214,6 +380,28 @@ auto iequals(char const *a, char const *b) -> bool {
     return a != nullptr && *a == '\0';
 }
 
+//! Parse a non-negative integer at the beginning of value advancing value.
+//!
+//! Fails if value does not start with a digit or if the integer does not
+//! fit into T.
+template <typename T> auto parse_uint(char const *&value, T &result) -> bool {
+    if (isdigit(*value) == 0) {
+        return false;
+    }
+    T res = 0;
+    for (; isdigit(*value) != 0; ++value) { // NOLINT
+        auto digit = static_cast<T>(*value - '0');
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+        if (res > (std::numeric_limits<T>::max() - digit) / 10) {
+            return false;
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+        res = (10 * res) + digit;
+    }
+    result = res;
+    return true;
+}
+
 //! Parse a Boolean and store it in data.
 //!
 //! Return false if there is a parse error.
@@ -284,6 +472,136 @@ auto parse_store(const char *value, void *data) -> bool {
     return false;
 }
 
+//! Parse value for the portfolio configuration.
+auto parse_portfolio(const char *value, void *data) -> bool {
+    auto &options = *static_cast<Options *>(data);
+    if (iequals(value, "none")) {
+        options.portfolio = Portfolio::None;
+        return true;
+    }
+    if (iequals(value, "mixed")) {
+        options.portfolio = Portfolio::Mixed;
+        return true;
+    }
+    return false;
+}
+
+//! Parse value for the rule selecting entering variables.
+auto parse_entering(const char *value, void *data) -> bool {
+    auto &options = *static_cast<Options *>(data);
+    if (iequals(value, "bland")) {
+        options.entering = EnteringRule::Bland;
+        return true;
+    }
+    if (iequals(value, "markowitz")) {
+        options.entering = EnteringRule::Markowitz;
+        return true;
+    }
+    return false;
+}
+
+//! Parse the simplex engine and store whether the revised engine is used.
+auto parse_engine(const char *value, void *data) -> bool {
+    auto &revised = *static_cast<bool *>(data);
+    if (iequals(value, "tableau")) {
+        revised = false;
+        return true;
+    }
+    if (iequals(value, "revised")) {
+        revised = true;
+        return true;
+    }
+    return false;
+}
+
+//! Parse the factor and whether to refresh at restarts.
+auto parse_refresh(const char *value, void *data) -> bool {
+    auto &options = *static_cast<Options *>(data);
+    size_t factor = 0;
+    if (!parse_uint(value, factor)) {
+        return false;
+    }
+    bool restart = false;
+    if (*value != '\0') {
+        if (!iequals(value, ",restart")) {
+            return false;
+        }
+        restart = true;
+    }
+    options.refresh_factor = factor;
+    options.refresh_restart = restart;
+    return true;
+}
+
+//! Parse the number of threads to evaluate theory atoms.
+auto parse_parse_threads(const char *value, void *data) -> bool {
+    auto &options = *static_cast<Options *>(data);
+    size_t threads = 0;
+    if (!parse_uint(value, threads) || *value != '\0' || threads == 0) {
+        return false;
+    }
+    options.parse_threads = threads;
+    return true;
+}
+
+//! Parse the names and arities of variables whose values are added to models.
+auto parse_show_values(const char *value, void *data) -> bool {
+    auto &options = *static_cast<Options *>(data);
+    if (iequals(value, "all")) {
+        options.show_values = std::nullopt;
+        return true;
+    }
+    if (iequals(value, "none")) {
+        options.show_values.emplace();
+        return true;
+    }
+    std::vector<std::pair<std::string, uint32_t>> signatures;
+    while (true) {
+        auto const *slash = strchr(value, '/');
+        if (slash == nullptr || slash == value) {
+            return false;
+        }
+        std::string name(value, slash);
+        value = slash + 1; // NOLINT
+        uint32_t arity = 0;
+        if (!parse_uint(value, arity)) {
+            return false;
+        }
+        signatures.emplace_back(std::move(name), arity);
+        if (*value == '\0') {
+            break;
+        }
+        if (*value != ',') {
+            return false;
+        }
+        ++value; // NOLINT
+    }
+    options.show_values = std::move(signatures);
+    return true;
+}
+
+//! Parse the name of the file calls to the solvers are recorded to.
+auto parse_record(const char *value, void *data) -> bool {
+    auto &options = *static_cast<Options *>(data);
+    if (*value == '\0') {
+        return false;
+    }
+    options.record = value;
+    return true;
+}
+
+#ifdef CLINGOLPX_TRACE
+//! Parse the name of the file trace events are written to.
+auto parse_trace(const char *value, void *data) -> bool {
+    auto &options = *static_cast<Options *>(data);
+    if (*value == '\0') {
+        return false;
+    }
+    options.trace = value;
+    return true;
+}
+#endif
+
 //! Parse how objective function is treated.
 auto parse_objective(const char *value, void *data) -> bool {
     auto &options = *static_cast<Options *>(data);
@@ -312,6 +630,14 @@ auto parse_objective(const char *value, void *data) -> bool {
     return true;
 }
 
+//! Convert a fraction given by a numerator and a denominator into a rational.
+auto to_rational(int64_t num, int64_t den) -> Rational {
+    if (den == 0) {
+        throw std::invalid_argument("denominator must not be zero");
+    }
+    return Rational{Integer::from_int64(num), Integer::from_int64(den)};
+}
+
 //! Set the given error message if the Boolean is false.
 //!
 //! Return false if there is a parse error.
@@ -330,6 +656,7 @@ struct clingolpx_theory {
     std::unique_ptr<PropagatorFacade> clingolpx{nullptr};
     Options options;
     bool strict{false};
+    bool revised{false};
 };
 
 extern "C" void clingolpx_version(int *major, int *minor, int *patch) {
@@ -351,11 +678,42 @@ extern "C" auto clingolpx_create(clingolpx_theory_t **theory) -> bool {
 
 extern "C" auto clingolpx_register(clingolpx_theory_t *theory, clingo_control_t *control) -> bool {
     CLINGOLPX_TRY {
-        if (!theory->strict) {
-            theory->clingolpx = std::make_unique<LPXPropagatorFacade<Rational>>(control, THEORY, theory->options);
+        auto const &options = theory->options;
+        if (!theory->strict && !theory->revised) {
+            theory->clingolpx = std::make_unique<LPXPropagatorFacade<Rational, Tableau>>(control, THEORY, options);
+        } else if (!theory->strict) {
+            theory->clingolpx =
+                std::make_unique<LPXPropagatorFacade<Rational, RevisedTableau>>(control, THEORY, options);
+        } else if (!theory->revised) {
+            theory->clingolpx = std::make_unique<LPXPropagatorFacade<RationalQ, Tableau>>(control, THEORY_Q, options);
         } else {
-            theory->clingolpx = std::make_unique<LPXPropagatorFacade<RationalQ>>(control, THEORY_Q, theory->options);
+            theory->clingolpx =
+                std::make_unique<LPXPropagatorFacade<RationalQ, RevisedTableau>>(control, THEORY_Q, options);
+        }
+    }
+    CLINGOLPX_CATCH;
+}
+
+extern "C" auto clingolpx_add_constraint(clingolpx_theory_t *theory, clingo_literal_t literal,
+                                         clingo_symbol_t const *variables, int64_t const *numerators,
+                                         int64_t const *denominators, size_t size, clingolpx_relation_t relation,
+                                         int64_t rhs_numerator, int64_t rhs_denominator) -> bool {
+    CLINGOLPX_TRY {
+        if (theory->clingolpx == nullptr) {
+            throw std::runtime_error("the theory has to be registered before adding constraints");
         }
+        if (relation < clingolpx_relation_less_equal || relation > clingolpx_relation_greater) {
+            throw std::invalid_argument("invalid relation");
+        }
+        std::vector<Term> lhs;
+        lhs.reserve(size);
+        for (size_t i = 0; i != size; ++i) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            lhs.emplace_back(Term{to_rational(numerators[i], denominators != nullptr ? denominators[i] : 1),
+                                  Clingo::Symbol{variables[i]}}); // NOLINT
+        }
+        theory->clingolpx->add_inequality(Inequality{std::move(lhs), to_rational(rhs_numerator, rhs_denominator),
+                                                     static_cast<Relation>(relation), literal});
     }
     CLINGOLPX_CATCH;
 }
@@ -373,7 +731,12 @@ extern "C" auto clingolpx_prepare(clingolpx_theory_t *theory, clingo_control_t *
 }
 
 extern "C" auto clingolpx_destroy(clingolpx_theory_t *theory) -> bool {
-    CLINGOLPX_TRY { delete theory; } // NOLINT
+    CLINGOLPX_TRY {
+        std::unique_ptr<clingolpx_theory> guard{theory};
+        if (guard->clingolpx != nullptr) {
+            guard->clingolpx->finish();
+        }
+    }
     CLINGOLPX_CATCH;
 }
 
@@ -382,12 +745,24 @@ extern "C" auto clingolpx_configure(clingolpx_theory_t *theory, char const *key,
         if (strcmp(key, "strict") == 0) {
             return check_parse("strict", parse_bool(value, &theory->strict));
         }
+        if (strcmp(key, "engine") == 0) {
+            return check_parse("engine", parse_engine(value, &theory->revised));
+        }
         if (strcmp(key, "objective") == 0) {
             return check_parse("objective", parse_bool(value, &theory->options.global_objective));
         }
         if (strcmp(key, "propagate-conflicts") == 0) {
             return check_parse("propagate-conflicts", parse_bool(value, &theory->options.propagate_conflicts));
         }
+        if (strcmp(key, "share-facts") == 0) {
+            return check_parse("share-facts", parse_bool(value, &theory->options.share_facts));
+        }
+        if (strcmp(key, "lazy-rows") == 0) {
+            return check_parse("lazy-rows", parse_bool(value, &theory->options.lazy_rows));
+        }
+        if (strcmp(key, "eliminate-fixed") == 0) {
+            return check_parse("eliminate-fixed", parse_bool(value, &theory->options.eliminate_fixed));
+        }
         if (strcmp(key, "propagate-bounds") == 0) {
             return check_parse("propagate-bounds", parse_propagate(value, &theory->options.propagate_mode));
         }
@@ -397,6 +772,32 @@ extern "C" auto clingolpx_configure(clingolpx_theory_t *theory, char const *key,
         if (strcmp(key, "store") == 0) {
             return check_parse("select", parse_store(value, &theory->options));
         }
+        if (strcmp(key, "entering") == 0) {
+            return check_parse("entering", parse_entering(value, &theory->options));
+        }
+        if (strcmp(key, "refresh") == 0) {
+            return check_parse("refresh", parse_refresh(value, &theory->options));
+        }
+        if (strcmp(key, "parse-threads") == 0) {
+            return check_parse("parse-threads", parse_parse_threads(value, &theory->options));
+        }
+        if (strcmp(key, "show-values") == 0) {
+            return check_parse("show-values", parse_show_values(value, &theory->options));
+        }
+        if (strcmp(key, "extend-model") == 0) {
+            return check_parse("extend-model", parse_bool(value, &theory->options.extend_model));
+        }
+        if (strcmp(key, "portfolio") == 0) {
+            return check_parse("portfolio", parse_portfolio(value, &theory->options));
+        }
+        if (strcmp(key, "record") == 0) {
+            return check_parse("record", parse_record(value, &theory->options));
+        }
+#ifdef CLINGOLPX_TRACE
+        if (strcmp(key, "trace") == 0) {
+            return check_parse("trace", parse_trace(value, &theory->options));
+        }
+#endif
         std::ostringstream msg;
         msg << "invalid configuration key '" << key << "'";
         clingo_set_error(clingo_error_runtime, msg.str().c_str());
@@ -412,6 +813,14 @@ extern "C" auto clingolpx_register_options(clingolpx_theory_t *theory, clingo_op
                                              &theory->strict));
         handle_error(clingo_options_add_flag(options, group, "propagate-conflicts", "Propagate conflicting bounds",
                                              &theory->options.propagate_conflicts));
+        handle_error(clingo_options_add_flag(options, group, "share-facts", "Share level-0 bounds among threads",
+                                             &theory->options.share_facts));
+        handle_error(clingo_options_add_flag(options, group, "lazy-rows",
+                                             "Maintain values of unbounded variables lazily (requires --store=partial)",
+                                             &theory->options.lazy_rows));
+        handle_error(clingo_options_add_flag(options, group, "eliminate-fixed",
+                                             "Eliminate variables fixed on decision level 0",
+                                             &theory->options.eliminate_fixed));
         handle_error(clingo_options_add(options, group, "propagate-bounds", "Propagate bounds", parse_propagate,
                                         &theory->options, false, "{none,changed,full}"));
         handle_error(clingo_options_add(options, group, "objective", "Choose how to treat objective function",
@@ -420,6 +829,26 @@ extern "C" auto clingolpx_register_options(clingolpx_theory_t *theory, clingo_op
                                         &theory->options, false, "{none,match,conflict}"));
         handle_error(clingo_options_add(options, group, "store", "Whether to store SAT assignments", parse_store,
                                         &theory->options, false, "{no,partial,total}"));
+        handle_error(clingo_options_add(options, group, "engine", "Choose the simplex engine", parse_engine,
+                                        &theory->revised, false, "{tableau,revised}"));
+        handle_error(clingo_options_add(options, group, "entering", "Choose the rule selecting entering variables",
+                                        parse_entering, &theory->options, false, "{bland,markowitz}"));
+        handle_error(clingo_options_add(options, group, "refresh", "Recompute the tableau from the inequalities",
+                                        parse_refresh, &theory->options, false, "<factor>[,restart]"));
+        handle_error(clingo_options_add(options, group, "parse-threads", "Number of threads to evaluate theory atoms",
+                                        parse_parse_threads, &theory->options, false, "<n>"));
+        handle_error(clingo_options_add(options, group, "show-values", "Choose variables whose values are shown",
+                                        parse_show_values, &theory->options, false, "{all,none,<sigs>}"));
+        handle_error(clingo_options_add_flag(options, group, "extend-model", "Add the shown values to models",
+                                             &theory->options.extend_model));
+        handle_error(clingo_options_add(options, group, "portfolio", "Configure solver threads differently",
+                                        parse_portfolio, &theory->options, false, "{none,mixed}"));
+        handle_error(clingo_options_add(options, group, "record", "Record the calls to the solvers for replaying",
+                                        parse_record, &theory->options, false, "<file>"));
+#ifdef CLINGOLPX_TRACE
+        handle_error(clingo_options_add(options, group, "trace", "Write solver events in Chrome's trace format",
+                                        parse_trace, &theory->options, false, "<file>"));
+#endif
     }
     CLINGOLPX_CATCH;
 }
@@ -430,6 +859,9 @@ extern "C" auto clingolpx_validate_options(clingolpx_theory_t *theory) -> bool {
             !theory->options.global_objective->is_rational()) {
             throw std::runtime_error("objective step value requires strict mode");
         }
+        if (theory->options.lazy_rows && theory->options.store_sat_assignment != StoreSATAssignments::Partial) {
+            throw std::runtime_error("lazy rows require storing satisfying assignments partially");
+        }
     }
     CLINGOLPX_CATCH;
 }
@@ -469,6 +901,42 @@ extern "C" void clingolpx_assignment_get_value(clingolpx_theory_t *theory, uint3
     theory->clingolpx->get_value(thread_id, index, value);
 }
 
+extern "C" auto clingolpx_assignment_get_values(clingolpx_theory_t *theory, uint32_t thread_id, size_t const *indices,
+                                                size_t size, clingolpx_rational_t *values) -> bool {
+    CLINGOLPX_TRY {
+        theory->clingolpx->get_values(thread_id, indices, size, values);
+    }
+    CLINGOLPX_CATCH;
+}
+
+extern "C" auto clingolpx_assignment_size(clingolpx_theory_t *theory, uint32_t thread_id) -> size_t {
+    return theory->clingolpx->n_values(thread_id);
+}
+
+extern "C" auto clingolpx_assignment_get_arrays(clingolpx_theory_t *theory, uint32_t thread_id, size_t size,
+                                                int64_t *numerators, int64_t *denominators, double *doubles) -> bool {
+    CLINGOLPX_TRY {
+        theory->clingolpx->get_arrays(thread_id, size, numerators, denominators, doubles);
+    }
+    CLINGOLPX_CATCH;
+}
+
+extern "C" auto clingolpx_assignment_get_shown(clingolpx_theory_t *theory, uint32_t thread_id, size_t const **indices,
+                                               size_t *size) -> bool {
+    CLINGOLPX_TRY {
+        theory->clingolpx->get_shown(thread_id, indices, size);
+    }
+    CLINGOLPX_CATCH;
+}
+
+extern "C" auto clingolpx_assignment_get_objective(clingolpx_theory_t *theory, uint32_t thread_id, bool *has_objective,
+                                                   clingolpx_value_t *value, bool *bounded) -> bool {
+    CLINGOLPX_TRY {
+        *has_objective = theory->clingolpx->get_objective(thread_id, value, bounded);
+    }
+    CLINGOLPX_CATCH;
+}
+
 extern "C" auto clingolpx_on_statistics(clingolpx_theory_t *theory, clingo_statistics_t *step,
                                         clingo_statistics_t *accu) -> bool {
     CLINGOLPX_TRY {
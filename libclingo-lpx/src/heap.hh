@@ -0,0 +1,153 @@
+#pragma once
+
+#include "util.hh"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+//! An indexed binary heap over non-negative integers.
+//!
+//! The heap remembers the position of each element, which makes it possible
+//! to test membership in constant time, to remove arbitrary elements, and to
+//! restore the heap property after the priority of an element changed.
+//!
+//! Priorities are given by the comparison function. An element `a` is
+//! extracted before an element `b` if `cmp(a, b)` holds. Hence, the default
+//! comparison extracts the smallest element first.
+//!
+//! Membership is tracked using epochs so that the heap can be cleared in
+//! constant time.
+template <typename Compare = std::less<>> class IndexedHeap {
+  public:
+    //! Construct an empty heap.
+    explicit IndexedHeap(Compare cmp = Compare{}) : cmp_{std::move(cmp)} {}
+
+    //! Check if the heap is empty.
+    [[nodiscard]] auto empty() const -> bool { return heap_.empty(); }
+
+    //! Return the number of elements in the heap.
+    [[nodiscard]] auto size() const -> size_t { return heap_.size(); }
+
+    //! Check if the heap contains the given element.
+    [[nodiscard]] auto contains(index_t x) const -> bool { return x < epoch_.size() && epoch_[x] == current_; }
+
+    //! Return the element with the highest priority.
+    //!
+    //! The heap must not be empty.
+    [[nodiscard]] auto top() const -> index_t {
+        assert(!empty());
+        return heap_.front();
+    }
+
+    //! Insert an element into the heap.
+    //!
+    //! Elements already in the heap are ignored. Runs in O(log(n)).
+    void push(index_t x) {
+        if (contains(x)) {
+            return;
+        }
+        if (x >= epoch_.size()) {
+            epoch_.resize(x + 1, 0);
+            position_.resize(x + 1, 0);
+        }
+        epoch_[x] = current_;
+        position_[x] = heap_.size();
+        heap_.emplace_back(x);
+        sift_up_(position_[x]);
+    }
+
+    //! Remove the element with the highest priority.
+    //!
+    //! The heap must not be empty. Runs in O(log(n)).
+    void pop() { remove(top()); }
+
+    //! Remove the given element from the heap (if contained).
+    //!
+    //! Runs in O(log(n)).
+    void remove(index_t x) {
+        if (!contains(x)) {
+            return;
+        }
+        auto pos = position_[x];
+        epoch_[x] = 0;
+        auto last = heap_.back();
+        heap_.pop_back();
+        if (last != x) {
+            place_(pos, last);
+            update(last);
+        }
+    }
+
+    //! Restore the heap property after the priority of the given element
+    //! changed.
+    //!
+    //! Runs in O(log(n)).
+    void update(index_t x) {
+        if (!contains(x)) {
+            return;
+        }
+        auto pos = position_[x];
+        if (pos > 0 && cmp_(x, heap_[parent_(pos)])) {
+            sift_up_(pos);
+        } else {
+            sift_down_(pos);
+        }
+    }
+
+    //! Remove all elements from the heap.
+    //!
+    //! Runs in O(1) (amortized).
+    void clear() {
+        heap_.clear();
+        if (++current_ == 0) {
+            std::fill(epoch_.begin(), epoch_.end(), 0);
+            current_ = 1;
+        }
+    }
+
+  private:
+    [[nodiscard]] static auto parent_(size_t pos) -> size_t { return (pos - 1) / 2; }
+    [[nodiscard]] static auto child_(size_t pos) -> size_t { return (2 * pos) + 1; }
+
+    void place_(size_t pos, index_t x) {
+        heap_[pos] = x;
+        position_[x] = pos;
+    }
+
+    void sift_up_(size_t pos) {
+        auto x = heap_[pos];
+        while (pos > 0 && cmp_(x, heap_[parent_(pos)])) {
+            place_(pos, heap_[parent_(pos)]);
+            pos = parent_(pos);
+        }
+        place_(pos, x);
+    }
+
+    void sift_down_(size_t pos) {
+        auto x = heap_[pos];
+        for (auto child = child_(pos); child < heap_.size(); child = child_(pos)) {
+            if (child + 1 < heap_.size() && cmp_(heap_[child + 1], heap_[child])) {
+                ++child;
+            }
+            if (!cmp_(heap_[child], x)) {
+                break;
+            }
+            place_(pos, heap_[child]);
+            pos = child;
+        }
+        place_(pos, x);
+    }
+
+    //! The elements arranged as a binary heap.
+    std::vector<index_t> heap_;
+    //! The position of each element in the heap.
+    std::vector<size_t> position_;
+    //! The epoch in which an element has been inserted.
+    std::vector<uint32_t> epoch_;
+    //! The current epoch.
+    uint32_t current_{1};
+    //! The comparison function.
+    Compare cmp_;
+};
@@ -106,6 +106,10 @@ class RationalQ {
     void swap(RationalQ &q);
     [[nodiscard]] auto is_rational() const -> bool;
     [[nodiscard]] auto as_rational() const -> Rational const &;
+    //! Get the rational component.
+    [[nodiscard]] auto c() const -> Rational const &;
+    //! Get the coefficient of the epsilon component.
+    [[nodiscard]] auto k() const -> Rational const &;
 
   private:
     Rational c_;
@@ -128,6 +132,10 @@ inline auto RationalQ::as_rational() const -> Rational const & {
     return c_;
 }
 
+inline auto RationalQ::c() const -> Rational const & { return c_; }
+
+inline auto RationalQ::k() const -> Rational const & { return k_; }
+
 // comparision
 
 [[nodiscard]] inline auto compare(RationalQ const &a, fixed_int b) -> int {
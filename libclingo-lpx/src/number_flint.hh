@@ -5,6 +5,9 @@
 #include <flint/fmpq.h>
 #include <flint/fmpz.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <ios>
 #include <iostream>
 #include <limits>
@@ -86,6 +89,9 @@ class Integer {
     auto neg() -> Integer &;
     [[nodiscard]] auto impl() const -> fmpz &;
     [[nodiscard]] auto as_int() const -> std::optional<int>;
+    [[nodiscard]] auto as_int64() const -> std::optional<int64_t>;
+    [[nodiscard]] static auto from_int64(int64_t val) -> Integer;
+    [[nodiscard]] auto bits() const -> size_t;
 
   private:
     mutable fmpz num_;
@@ -184,6 +190,7 @@ class Rational {
     auto neg() -> Rational &;
     void swap(Rational &x) noexcept;
     void canonicalize();
+    [[nodiscard]] auto as_double() const -> double;
 
   private:
     mutable fmpq num_;
@@ -252,6 +259,34 @@ inline auto Integer::as_int() const -> std::optional<int> {
     return std::nullopt;
 }
 
+inline auto Integer::as_int64() const -> std::optional<int64_t> {
+    if (fmpz_fits_si(&num_)) {
+        return static_cast<int64_t>(fmpz_get_si(&num_));
+    }
+    return std::nullopt;
+}
+
+inline auto Integer::from_int64(int64_t val) -> Integer {
+    if constexpr (sizeof(slong) >= sizeof(int64_t)) {
+        return Integer{static_cast<fixed_int>(val)};
+    } else {
+        // The magnitude is converted in two halves on 32 bit platforms.
+        constexpr ulong half = 32;
+        constexpr uint64_t mask = 0xFFFFFFFF;
+        auto mag = val < 0 ? 0 - static_cast<uint64_t>(val) : static_cast<uint64_t>(val);
+        Integer ret;
+        fmpz_set_ui(&ret.num_, static_cast<ulong>(mag >> half));
+        fmpz_mul_2exp(&ret.num_, &ret.num_, half);
+        fmpz_add_ui(&ret.num_, &ret.num_, static_cast<ulong>(mag & mask));
+        if (val < 0) {
+            ret.neg();
+        }
+        return ret;
+    }
+}
+
+inline auto Integer::bits() const -> size_t { return fmpz_bits(&num_); }
+
 inline auto Integer::impl() const -> fmpz & { return num_; }
 
 // addition
@@ -515,6 +550,17 @@ inline auto Rational::neg() -> Rational & {
 inline void Rational::swap(Rational &x) noexcept { fmpq_swap(&num_, &x.num_); }
 
 inline void Rational::canonicalize() { fmpq_canonicalise(&num_); }
+
+inline auto Rational::as_double() const -> double {
+    // Numerator and denominator are converted separately with their
+    // exponents so that numbers of any size can be handled.
+    slong num_exp = 0;
+    slong den_exp = 0;
+    auto num = fmpz_get_d_2exp(&num_exp, fmpq_numref(&num_));
+    auto den = fmpz_get_d_2exp(&den_exp, fmpq_denref(&num_));
+    auto exp = std::clamp<slong>(num_exp - den_exp, std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    return std::ldexp(num / den, static_cast<int>(exp));
+}
 // addition
 
 [[nodiscard]] inline auto operator+(Rational const &a, fixed_int b) -> Rational {
@@ -5,6 +5,8 @@
 #include <imath.h>
 #include <imrat.h>
 
+#include <cmath>
+#include <cstdint>
 #include <ios>
 #include <iostream>
 #include <limits>
@@ -86,6 +88,9 @@ class Integer {
     auto add_mul(Integer const &a, Integer const &b) && -> Integer;
     auto neg() -> Integer &;
     [[nodiscard]] auto as_int() const -> std::optional<int>;
+    [[nodiscard]] auto as_int64() const -> std::optional<int64_t>;
+    [[nodiscard]] static auto from_int64(int64_t val) -> Integer;
+    [[nodiscard]] auto bits() const -> size_t;
     [[nodiscard]] auto impl() const -> mpz_t &;
 
   private:
@@ -185,6 +190,7 @@ class Rational {
     auto neg() -> Rational &;
     void swap(Rational &x) noexcept;
     void canonicalize();
+    [[nodiscard]] auto as_double() const -> double;
 
   private:
     mutable mpq_t num_;
@@ -264,6 +270,56 @@ inline auto Integer::as_int() const -> std::optional<int> {
     return std::nullopt;
 }
 
+inline auto Integer::as_int64() const -> std::optional<int64_t> {
+    // Type mp_small might only have 32 bits. Hence, the magnitude is
+    // converted in two halves.
+    constexpr mp_small half = 32;
+    constexpr mp_result max_bits = 64;
+    if (mp_int_count_bits(&num_) > max_bits) {
+        return std::nullopt;
+    }
+    Integer hi;
+    Integer lo;
+    mp_handle_error_(mp_int_abs(&num_, &hi.num_));
+    mp_handle_error_(mp_int_div_pow2(&hi.num_, half, &hi.num_, &lo.num_));
+    mp_usmall hi_val = 0;
+    mp_usmall lo_val = 0;
+    mp_handle_error_(mp_int_to_uint(&hi.num_, &hi_val));
+    mp_handle_error_(mp_int_to_uint(&lo.num_, &lo_val));
+    auto mag = (static_cast<uint64_t>(hi_val) << half) | static_cast<uint64_t>(lo_val);
+    if (mp_int_compare_zero(&num_) < 0) {
+        if (mag > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1) {
+            return std::nullopt;
+        }
+        return mag == static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1
+                   ? std::numeric_limits<int64_t>::min()
+                   : -static_cast<int64_t>(mag);
+    }
+    if (mag > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+        return std::nullopt;
+    }
+    return static_cast<int64_t>(mag);
+}
+
+inline auto Integer::from_int64(int64_t val) -> Integer {
+    // See as_int64.
+    constexpr mp_small half = 32;
+    constexpr uint64_t mask = 0xFFFFFFFF;
+    auto mag = val < 0 ? 0 - static_cast<uint64_t>(val) : static_cast<uint64_t>(val);
+    Integer ret;
+    Integer lo;
+    mp_handle_error_(mp_int_set_uvalue(&ret.num_, static_cast<mp_usmall>(mag >> half)));
+    mp_handle_error_(mp_int_set_uvalue(&lo.num_, static_cast<mp_usmall>(mag & mask)));
+    mp_handle_error_(mp_int_mul_pow2(&ret.num_, half, &ret.num_));
+    mp_handle_error_(mp_int_add(&ret.num_, &lo.num_, &ret.num_));
+    if (val < 0) {
+        ret.neg();
+    }
+    return ret;
+}
+
+inline auto Integer::bits() const -> size_t { return static_cast<size_t>(mp_int_count_bits(&num_)); }
+
 inline auto Integer::impl() const -> mpz_t & { return num_; }
 
 // addition
@@ -493,6 +549,40 @@ inline void Rational::swap(Rational &x) noexcept {
 
 inline void Rational::canonicalize() { mp_handle_error_(mp_rat_reduce(&num_)); }
 
+inline auto Rational::as_double() const -> double {
+    // The quotient is scaled to 62 significant bits, which are converted in
+    // two halves, so that numerators and denominators of any size can be
+    // handled.
+    constexpr mp_small precision = 62;
+    constexpr mp_small half = 32;
+    auto *num = mp_rat_numer_ref(&num_);
+    auto *den = mp_rat_denom_ref(&num_);
+    if (mp_int_compare_zero(num) == 0) {
+        return 0;
+    }
+    auto shift = precision - mp_int_count_bits(num) + mp_int_count_bits(den);
+    Integer a;
+    Integer b;
+    mp_handle_error_(mp_int_abs(num, &a.impl()));
+    mp_handle_error_(mp_int_copy(den, &b.impl()));
+    if (shift > 0) {
+        mp_handle_error_(mp_int_mul_pow2(&a.impl(), shift, &a.impl()));
+    } else if (shift < 0) {
+        mp_handle_error_(mp_int_mul_pow2(&b.impl(), -shift, &b.impl()));
+    }
+    a.divide(b);
+    Integer hi;
+    Integer lo;
+    mp_handle_error_(mp_int_div_pow2(&a.impl(), half, &hi.impl(), &lo.impl()));
+    mp_usmall hi_val = 0;
+    mp_usmall lo_val = 0;
+    mp_handle_error_(mp_int_to_uint(&hi.impl(), &hi_val));
+    mp_handle_error_(mp_int_to_uint(&lo.impl(), &lo_val));
+    auto ret = std::ldexp(std::ldexp(static_cast<double>(hi_val), half) + static_cast<double>(lo_val),
+                          -static_cast<int>(shift));
+    return mp_int_compare_zero(num) < 0 ? -ret : ret;
+}
+
 // addition
 
 [[nodiscard]] inline auto operator+(Rational const &a, fixed_int b) -> Rational { return a + Integer{b}; }
@@ -4,10 +4,12 @@
 #include <clingo.hh>
 
 #include <algorithm>
+#include <exception>
 #include <iterator>
 #include <optional>
 #include <regex>
 #include <stdexcept>
+#include <thread>
 #include <unordered_map>
 #include <variant>
 
@@ -104,7 +106,7 @@ struct AS {
     if (len <= 2 || name[0] != '"' || name[len - 1] != '"') {
         return std::nullopt;
     }
-    std::regex const rgx{"(-)?([0-9]+)(\\.([0-9]+))?"};
+    static std::regex const rgx{"(-)?([0-9]+)(\\.([0-9]+))?"};
     std::cmatch match;
     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
     if (!std::regex_match(name + 1, name + len - 1, match, rgx)) {
@@ -272,35 +274,57 @@ auto parse_diff_elem(Clingo::TheoryTerm const &term) -> std::vector<Term> {
     return res;
 }
 
-void parse_sum_elem(Clingo::TheoryTerm const &term, std::vector<Term> &res) {
+//! Cache for sum elements and variables indexed by theory term ids.
+//!
+//! Clingo represents equal theory terms by the same id. Hence, elements and
+//! variables shared among atoms only have to be evaluated once. Compound
+//! terms within elements are not cached because each of them would store a
+//! copy of the terms of its subterms.
+struct SumCache {
+    //! The terms of evaluated sum elements.
+    std::unordered_map<Clingo::id_t, std::vector<Term>> elems;
+    //! The evaluated variables.
+    std::unordered_map<Clingo::id_t, Clingo::Symbol> vars;
+};
+
+[[nodiscard]] auto parse_sum_var(SumCache &cache, Clingo::TheoryTerm const &term) -> Clingo::Symbol {
+    if (auto it = cache.vars.find(term.to_c()); it != cache.vars.end()) {
+        return it->second;
+    }
+    auto var = evaluate_var(term);
+    cache.vars.emplace(term.to_c(), var);
+    return var;
+}
+
+void parse_sum_term(SumCache &cache, Clingo::TheoryTerm const &term, std::vector<Term> &res) {
     if (term.type() == Clingo::TheoryTermType::Number) {
         res.emplace_back(Term{FWD(term.number()), Clingo::Number(0)});
     } else if (match(term, "+", 2)) {
         auto args = term.arguments();
-        parse_sum_elem(args.front(), res);
-        parse_sum_elem(args.back(), res);
+        parse_sum_term(cache, args.front(), res);
+        parse_sum_term(cache, args.back(), res);
     } else if (match(term, "-", 2)) {
         auto args = term.arguments();
-        parse_sum_elem(args.front(), res);
+        parse_sum_term(cache, args.front(), res);
         auto pos = res.size();
-        parse_sum_elem(args.back(), res);
+        parse_sum_term(cache, args.back(), res);
         for (auto it = res.begin() + pos, ie = res.end(); it != ie; ++it) {
             it->co = -it->co;
         }
     } else if (match(term, "-", 1)) {
         auto pos = res.size();
-        parse_sum_elem(term.arguments().front(), res);
+        parse_sum_term(cache, term.arguments().front(), res);
         for (auto it = res.begin() + pos, ie = res.end(); it != ie; ++it) {
             it->co = -it->co;
         }
     } else if (match(term, "+", 1)) {
-        parse_sum_elem(term.arguments().front(), res);
+        parse_sum_term(cache, term.arguments().front(), res);
     } else if (match(term, "*", 2)) {
         auto args = term.arguments();
         std::vector<Term> lhs;
         std::vector<Term> rhs;
-        parse_sum_elem(args.front(), lhs);
-        parse_sum_elem(args.back(), rhs);
+        parse_sum_term(cache, args.front(), lhs);
+        parse_sum_term(cache, args.back(), rhs);
         for (auto &[l_co, l_var] : lhs) {
             for (auto &[r_co, r_var] : rhs) {
                 check_syntax(is_invalid(l_var) || is_invalid(r_var));
@@ -311,7 +335,7 @@ void parse_sum_elem(Clingo::TheoryTerm const &term, std::vector<Term> &res) {
     } else if (match(term, "/", 2)) {
         auto args = term.arguments();
         std::vector<Term> lhs;
-        parse_sum_elem(args.front(), lhs);
+        parse_sum_term(cache, args.front(), lhs);
         auto rhs = evaluate_num(args.back());
         check_syntax(rhs != 0);
         for (auto &[co, var] : lhs) {
@@ -321,32 +345,79 @@ void parse_sum_elem(Clingo::TheoryTerm const &term, std::vector<Term> &res) {
         if (auto num = as_num(term.name())) {
             res.emplace_back(Term{*num, Clingo::Number(0)});
         } else {
-            res.emplace_back(Term{1, evaluate_var(term)});
+            res.emplace_back(Term{1, parse_sum_var(cache, term)});
         }
     } else if (term.type() == Clingo::TheoryTermType::Symbol || term.type() == Clingo::TheoryTermType::Function ||
                term.type() == Clingo::TheoryTermType::Tuple) {
-        res.emplace_back(Term{1, evaluate_var(term)});
+        res.emplace_back(Term{1, parse_sum_var(cache, term)});
     } else {
         throw_syntax_error("Invalid Syntax: invalid sum constraint");
     }
 }
 
-[[nodiscard]] auto parse_sum_elems(LitMapper const &mapper, VarMap &var_map, std::vector<Inequality> &iqs,
-                                   Clingo::TheoryElementSpan elements) -> std::vector<Term> {
+void parse_sum_elem(SumCache &cache, Clingo::TheoryTerm const &term, std::vector<Term> &res) {
+    if (auto it = cache.elems.find(term.to_c()); it != cache.elems.end()) {
+        res.insert(res.end(), it->second.begin(), it->second.end());
+        return;
+    }
+    auto n = res.size();
+    parse_sum_term(cache, term, res);
+    cache.elems.emplace(term.to_c(), std::vector<Term>(res.begin() + static_cast<std::ptrdiff_t>(n), res.end()));
+}
+
+//! The inequalities and objective terms obtained from a range of theory
+//! atoms.
+//!
+//! Chunks can be evaluated independently. Literals are mapped and variables
+//! for conditional elements are introduced only when merging the chunks in
+//! order. Until then, such variables are represented by negative numbers
+//! referring to the auxiliary variables of the chunk. Note that numbers can
+//! never be variables otherwise.
+struct Chunk {
+    //! An inequality or objective terms of an atom.
+    struct Item {
+        //! The number of auxiliary variables required by the item.
+        size_t aux;
+        //! The inequality or the objective terms stored in its left-hand side.
+        Inequality iq;
+        //! Whether the item holds objective terms.
+        bool objective;
+    };
+
+    //! Add an item holding an inequality.
+    void add(Inequality iq) { items.emplace_back(Item{aux.size(), std::move(iq), false}); }
+    //! Add an item holding objective terms.
+    void add(std::vector<Term> terms) {
+        items.emplace_back(Item{aux.size(), Inequality{std::move(terms), 0, Relation::Equal, 0}, true});
+    }
+
+    //! The auxiliary variables in the order they have been introduced.
+    std::vector<std::pair<Clingo::Symbol, Clingo::literal_t>> aux;
+    //! Mapping from auxiliary variables to their placeholders.
+    VarMap aux_map;
+    //! The items in the order of the atoms.
+    std::vector<Item> items;
+    //! The cache of evaluated sum elements.
+    SumCache cache;
+    //! Map for combining coefficients.
+    std::unordered_map<Clingo::Symbol, Term &> cos;
+    //! The first error that occurred while evaluating the chunk.
+    std::exception_ptr error;
+};
+
+[[nodiscard]] auto parse_sum_elems(Chunk &chunk, Clingo::TheoryElementSpan elements) -> std::vector<Term> {
     std::vector<Term> lhs;
     for (auto &&elem : elements) {
         check_syntax(elem.tuple().size() == 1);
         auto &&term = elem.tuple().front();
         size_t n = lhs.size();
-        parse_sum_elem(term, lhs);
+        parse_sum_elem(chunk.cache, term, lhs);
         if (!elem.condition().empty()) {
             for (auto it = lhs.begin() + n, ie = lhs.end(); it != ie; ++it) {
-                auto res = var_map.try_emplace(std::make_pair(it->var, elem.condition_id()),
-                                               Clingo::Number(safe_cast<int>(var_map.size() + 1)));
+                auto res = chunk.aux_map.try_emplace(std::make_pair(it->var, elem.condition_id()),
+                                                     Clingo::Number(-safe_cast<int>(chunk.aux.size() + 1)));
                 if (res.second) {
-                    auto lit = mapper(elem.condition_id());
-                    iqs.emplace_back(Inequality{{{1, res.first->second}}, 0, Relation::Equal, -lit});
-                    iqs.emplace_back(Inequality{{{1, res.first->second}, {-1, it->var}}, 0, Relation::Equal, lit});
+                    chunk.aux.emplace_back(res.first->first);
                 }
                 it->var = res.first->second;
             }
@@ -356,21 +427,37 @@ void parse_sum_elem(Clingo::TheoryTerm const &term, std::vector<Term> &res) {
 }
 
 auto simplify(std::unordered_map<Clingo::Symbol, Term &> &cos, std::vector<Term> &terms) -> Rational {
+    // For short sums, a linear search is cheaper than hashing.
+    static constexpr size_t short_sum = 8;
+
     auto ib = terms.begin();
     auto ie = terms.end();
 
     auto rhs = Rational{0};
     // combine cofficients
-    cos.clear();
-    std::for_each(ib, ie, [&cos, &rhs](Term &term) {
-        if (is_invalid(term.var)) {
-            rhs -= std::move(term.co);
-            term.co = 0;
-        } else if (auto [jt, res] = cos.emplace(term.var, term); !res) {
-            jt->second.co += std::move(term.co);
-            term.co = 0;
+    if (terms.size() <= short_sum) {
+        for (auto it = ib; it != ie; ++it) {
+            if (is_invalid(it->var)) {
+                rhs -= std::move(it->co);
+                it->co = 0;
+            } else if (auto jt = std::find_if(ib, it, [&it](Term const &term) { return term.var == it->var; });
+                       jt != it) {
+                jt->co += std::move(it->co);
+                it->co = 0;
+            }
         }
-    });
+    } else {
+        cos.clear();
+        std::for_each(ib, ie, [&cos, &rhs](Term &term) {
+            if (is_invalid(term.var)) {
+                rhs -= std::move(term.co);
+                term.co = 0;
+            } else if (auto [jt, res] = cos.emplace(term.var, term); !res) {
+                jt->second.co += std::move(term.co);
+                term.co = 0;
+            }
+        });
+    }
 
     // remove terms with zero coeffcients
     terms.erase(std::remove_if(ib, ie, [](Term const &term) { return term.co == 0; }), ie);
@@ -378,63 +465,136 @@ auto simplify(std::unordered_map<Clingo::Symbol, Term &> &cos, std::vector<Term>
     return rhs;
 }
 
-void parse_theory(Clingo::TheoryAtoms const &theory, LitMapper const &mapper, VarMap &var_map,
-                  std::vector<Inequality> &iqs, std::vector<Term> &objective) {
-    std::unordered_map<Clingo::Symbol, Term &> cos;
-    for (auto &&atom : theory) {
-        if (match(atom.term(), "dom", 0)) {
-            check_syntax(atom.elements().size() == 1);
-            auto &&elem = atom.elements().front();
-            check_syntax(elem.tuple().size() == 1 && elem.condition().empty());
-            auto &&term = elem.tuple().front();
-            check_syntax(atom.has_guard(), "&dom constraints need guards");
-            check_syntax(match(term, "..", 2), "interval in &dom constraint expected");
-            auto var = evaluate_var(atom.guard().second);
-            auto lit = mapper(atom.literal());
-            iqs.emplace_back(Inequality{{{1, var}}, evaluate_num(term.arguments().back()), Relation::LessEqual, lit});
-            iqs.emplace_back(
-                Inequality{{{1, var}}, evaluate_num(term.arguments().front()), Relation::GreaterEqual, lit});
-        } else if (match(atom.term(), "diff", 0)) {
-            check_syntax(atom.has_guard() && atom.elements().size() == 1 &&
-                             atom.elements().front().tuple().size() == 1 && atom.elements().front().condition().empty(),
-                         "&diff invalid difference constraint");
-            auto lhs = parse_diff_elem(atom.elements().begin()->tuple().front());
-            size_t n = lhs.size();
-            parse_sum_elem(atom.guard().second, lhs);
-            for (auto it = lhs.begin() + n, ie = lhs.end(); it != ie; ++it) {
-                it->co.neg();
+void parse_atom(Chunk &chunk, Clingo::TheoryAtom const &atom) {
+    if (match(atom.term(), "dom", 0)) {
+        check_syntax(atom.elements().size() == 1);
+        auto &&elem = atom.elements().front();
+        check_syntax(elem.tuple().size() == 1 && elem.condition().empty());
+        auto &&term = elem.tuple().front();
+        check_syntax(atom.has_guard(), "&dom constraints need guards");
+        check_syntax(match(term, "..", 2), "interval in &dom constraint expected");
+        auto var = evaluate_var(atom.guard().second);
+        auto lit = atom.literal();
+        chunk.add(Inequality{{{1, var}}, evaluate_num(term.arguments().back()), Relation::LessEqual, lit});
+        chunk.add(Inequality{{{1, var}}, evaluate_num(term.arguments().front()), Relation::GreaterEqual, lit});
+    } else if (match(atom.term(), "diff", 0)) {
+        check_syntax(atom.has_guard() && atom.elements().size() == 1 && atom.elements().front().tuple().size() == 1 &&
+                         atom.elements().front().condition().empty(),
+                     "&diff invalid difference constraint");
+        auto lhs = parse_diff_elem(atom.elements().begin()->tuple().front());
+        size_t n = lhs.size();
+        parse_sum_elem(chunk.cache, atom.guard().second, lhs);
+        for (auto it = lhs.begin() + n, ie = lhs.end(); it != ie; ++it) {
+            it->co.neg();
+        }
+        auto rhs = simplify(chunk.cos, lhs);
+        chunk.add(Inequality{std::move(lhs), std::move(rhs), evaluate_cmp(atom.guard().first), atom.literal()});
+    } else if (match(atom.term(), "sum", 0)) {
+        check_syntax(atom.has_guard(), "&sum constraints need guards");
+        auto lhs = parse_sum_elems(chunk, atom.elements());
+        size_t n = lhs.size();
+        parse_sum_elem(chunk.cache, atom.guard().second, lhs);
+        for (auto it = lhs.begin() + n, ie = lhs.end(); it != ie; ++it) {
+            it->co.neg();
+        }
+        auto rhs = simplify(chunk.cos, lhs);
+        chunk.add(Inequality{std::move(lhs), std::move(rhs), evaluate_cmp(atom.guard().first), atom.literal()});
+    } else if (match(atom.term(), "minimize", 0) || match(atom.term(), "maximize", 0)) {
+        auto lhs = parse_sum_elems(chunk, atom.elements());
+        if (match(atom.term(), "minimize", 0)) {
+            for (auto &term : lhs) {
+                term.co.neg();
             }
-            auto rhs = simplify(cos, lhs);
-            auto lit = mapper(atom.literal());
-            iqs.emplace_back(Inequality{std::move(lhs), std::move(rhs), evaluate_cmp(atom.guard().first), lit});
-        } else if (match(atom.term(), "sum", 0)) {
-            check_syntax(atom.has_guard(), "&sum constraints need guards");
-            auto lhs = parse_sum_elems(mapper, var_map, iqs, atom.elements());
-            size_t n = lhs.size();
-            parse_sum_elem(atom.guard().second, lhs);
-            for (auto it = lhs.begin() + n, ie = lhs.end(); it != ie; ++it) {
-                it->co.neg();
+        }
+        chunk.add(std::move(lhs));
+    }
+}
+
+void parse_chunk(Chunk &chunk, std::vector<Clingo::TheoryAtom> const &atoms, size_t begin, size_t end) {
+    try {
+        for (auto i = begin; i != end; ++i) {
+            parse_atom(chunk, atoms[i]);
+        }
+    } catch (...) {
+        chunk.error = std::current_exception();
+    }
+}
+
+void merge_chunk(Chunk &chunk, LitMapper const &mapper, VarMap &var_map, std::vector<Inequality> &iqs,
+                 std::vector<Term> &objective) {
+    if (chunk.error) {
+        std::rethrow_exception(chunk.error);
+    }
+    std::vector<Clingo::Symbol> vars;
+    vars.reserve(chunk.aux.size());
+    for (auto &item : chunk.items) {
+        for (auto i = vars.size(); i < item.aux; ++i) {
+            auto const &[var, cond] = chunk.aux[i];
+            auto res = var_map.try_emplace(chunk.aux[i], Clingo::Number(safe_cast<int>(var_map.size() + 1)));
+            if (res.second) {
+                auto lit = mapper(cond);
+                iqs.emplace_back(Inequality{{{1, res.first->second}}, 0, Relation::Equal, -lit});
+                iqs.emplace_back(Inequality{{{1, res.first->second}, {-1, var}}, 0, Relation::Equal, lit});
             }
-            auto rhs = simplify(cos, lhs);
-            auto lit = mapper(atom.literal());
-            iqs.emplace_back(Inequality{std::move(lhs), std::move(rhs), evaluate_cmp(atom.guard().first), lit});
-        } else if (match(atom.term(), "minimize", 0) || match(atom.term(), "maximize", 0)) {
-            auto lhs = parse_sum_elems(mapper, var_map, iqs, atom.elements());
-            if (match(atom.term(), "minimize", 0)) {
-                for (auto &term : lhs) {
-                    term.co.neg();
-                }
+            vars.emplace_back(res.first->second);
+        }
+        for (auto &term : item.iq.lhs) {
+            if (term.var.type() == Clingo::SymbolType::Number && term.var.number() < 0) {
+                term.var = vars[static_cast<size_t>(-term.var.number()) - 1];
             }
-            std::move(lhs.begin(), lhs.end(), std::back_inserter(objective));
+        }
+        if (item.objective) {
+            std::move(item.iq.lhs.begin(), item.iq.lhs.end(), std::back_inserter(objective));
+        } else {
+            item.iq.lit = mapper(item.iq.lit);
+            iqs.emplace_back(std::move(item.iq));
         }
     }
-    auto rhs = simplify(cos, objective);
-    check_syntax(rhs == 0, "objective must not contain constants");
 }
 
 } // namespace
 
 void evaluate_theory(Clingo::TheoryAtoms const &theory, LitMapper const &mapper, VarMap &var_map,
-                     std::vector<Inequality> &iqs, std::vector<Term> &objective) {
-    parse_theory(theory, mapper, var_map, iqs, objective);
+                     std::vector<Inequality> &iqs, std::vector<Term> &objective, size_t threads) {
+    std::vector<Clingo::TheoryAtom> atoms;
+    for (auto &&atom : theory) {
+        atoms.emplace_back(atom);
+    }
+
+    // The atoms are split into contiguous chunks, one per thread. Merging
+    // the chunks in order gives the same result as evaluating the atoms
+    // sequentially.
+    //
+    // Workers read theory atoms and create symbols concurrently. This relies
+    // on the note in the symbol module of clingo.h that all its functions
+    // are thread-safe and on the theory data not being modified while the
+    // propagator is initialized. Everything else touching the control, like
+    // mapping literals, only happens on this thread in merge_chunk.
+    auto n = std::max(size_t{1}, std::min(threads, atoms.size()));
+    std::vector<Chunk> chunks(n);
+    auto bound = [&](size_t i) { return i * atoms.size() / n; };
+    if (n == 1) {
+        parse_chunk(chunks.front(), atoms, 0, atoms.size());
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(n);
+        for (size_t i = 0; i != n; ++i) {
+            workers.emplace_back(parse_chunk, std::ref(chunks[i]), std::cref(atoms), bound(i), bound(i + 1));
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+    for (auto &chunk : chunks) {
+        merge_chunk(chunk, mapper, var_map, iqs, objective);
+    }
+
+    std::unordered_map<Clingo::Symbol, Term &> cos;
+    auto rhs = simplify(cos, objective);
+    check_syntax(rhs == 0, "objective must not contain constants");
+}
+
+void simplify(std::vector<Term> &terms) {
+    std::unordered_map<Clingo::Symbol, Term &> cos;
+    static_cast<void>(simplify(cos, terms));
 }
@@ -57,5 +57,14 @@ constexpr char const *THEORY_Q = R"(
 using VarMap = std::map<std::pair<Clingo::Symbol, Clingo::literal_t>, Clingo::Symbol>;
 using LitMapper = std::function<Clingo::literal_t(Clingo::literal_t)>;
 
+//! Evaluate the given theory atoms appending to the given inequalities and
+//! objective.
+//!
+//! The atoms are split into chunks evaluated by the given number of threads.
+//! The result does not depend on the number of threads.
 void evaluate_theory(Clingo::TheoryAtoms const &theory, LitMapper const &mapper, VarMap &var_map,
-                     std::vector<Inequality> &iqs, std::vector<Term> &objective);
+                     std::vector<Inequality> &iqs, std::vector<Term> &objective, size_t threads = 1);
+
+//! Combine terms over the same variable and remove terms with zero
+//! coefficients.
+void simplify(std::vector<Term> &terms);
@@ -0,0 +1,307 @@
+#include "parsing.hh"
+#include "solving.hh"
+
+#include <clingo.hh>
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+template <typename Value, typename Matrix> void Propagator<Value, Matrix>::init(Clingo::PropagateInit &init) {
+    // Events of the previous solve call are written here in case no
+    // statistics have been collected.
+    trace_.flush();
+    CLINGOLPX_TRACE_SCOPE(trace_.buffer(0), "init");
+    facts_offset_ = facts_.size();
+    share_facts_ = options_.share_facts && init.number_of_threads() > 1;
+    if (facts_offset_ > 0 || options_.global_objective.has_value() || share_facts_) {
+        init.set_check_mode(Clingo::PropagatorCheckMode::Both);
+    }
+
+    // Theory atoms are only passed once. Hence, inequalities of previous
+    // steps are kept and new ones appended.
+    auto n_iqs = iqs_.size();
+    auto n_objective = objective_.size();
+    evaluate_theory(
+        init.theory_atoms(), [&](Clingo::literal_t lit) { return init.solver_literal(lit); }, aux_map_, iqs_,
+        objective_, options_.parse_threads);
+    for (auto &x : pending_iqs_) {
+        x.lit = init.solver_literal(x.lit);
+        iqs_.emplace_back(std::move(x));
+    }
+    pending_iqs_.clear();
+
+    auto gather_vars = [this](std::vector<Term> const &terms) {
+        for (auto const &term : terms) {
+            if (var_map_.emplace(term.var, var_map_.size()).second) {
+                var_vec_.emplace_back(term.var);
+            }
+        }
+    };
+    gather_vars(objective_);
+    for (auto &x : iqs_) {
+        gather_vars(x.lhs);
+        init.add_watch(x.lit);
+    }
+    if (record_.is_open()) {
+        record_.init(init.number_of_threads(), iqs_, n_iqs, objective_, var_map_, init.assignment());
+    }
+
+    objective_state_.reset();
+
+    if (share_facts_) {
+        std::vector<Clingo::literal_t> lits;
+        lits.reserve(2 * iqs_.size());
+        for (auto const &x : iqs_) {
+            lits.emplace_back(x.lit);
+            lits.emplace_back(-x.lit);
+        }
+        fact_channel_.reset(std::move(lits));
+    }
+
+    // Solvers of the previous step are extended if possible. Otherwise, they
+    // are rebuilt from scratch.
+    //
+    // Extended solvers keep their offsets into the facts collected by the
+    // first thread. Thus, they replay the facts collected after their last
+    // replay, which other threads might not have seen in the previous step.
+    // Asserting the bound of a fact again does not change a solver.
+    if (slvs_.size() == static_cast<size_t>(init.number_of_threads()) && objective_.size() == n_objective &&
+        std::all_of(slvs_.begin(), slvs_.end(), [](auto const &slv) { return slv.second.extensible(); })) {
+        for (size_t i = 0, e = init.number_of_threads(); i != e; ++i) {
+            if (!slvs_[i].second.extend(init, var_map_, iqs_, n_iqs, i == 0)) {
+                return;
+            }
+        }
+        return;
+    }
+
+    // Note that the solvers store references to their options. Thus, the
+    // solvers have to be destroyed before the options are reassigned.
+    slvs_.clear();
+    thread_options_.clear();
+    thread_options_.reserve(init.number_of_threads());
+    for (size_t i = 0, e = init.number_of_threads(); i != e; ++i) {
+        thread_options_.emplace_back(thread_options(options_, i));
+    }
+    slvs_.reserve(init.number_of_threads());
+    for (size_t i = 0, e = init.number_of_threads(); i != e; ++i) {
+        slvs_.emplace_back(std::piecewise_construct, std::forward_as_tuple(0),
+                           std::forward_as_tuple(thread_options_[i], trace_.buffer(i)));
+        if (!slvs_.back().second.prepare(init, var_map_, iqs_, objective_, i == 0)) {
+            return;
+        }
+    }
+}
+
+template <typename Value, typename Matrix> void Propagator<Value, Matrix>::finish() {
+    trace_.close();
+    record_.close();
+}
+
+template <typename Value, typename Matrix> void Propagator<Value, Matrix>::register_control(Clingo::Control &ctl) {
+    ctl.register_propagator(*this);
+    if constexpr (std::is_same_v<Value, RationalQ>) {
+        ctl.add("base", {}, THEORY_Q);
+    } else {
+        ctl.add("base", {}, THEORY);
+    }
+}
+
+template <typename Value, typename Matrix>
+void Propagator<Value, Matrix>::on_statistics(Clingo::UserStatistics step, Clingo::UserStatistics accu) {
+    // Statistics are collected at the end of a solve call when no solver
+    // records events.
+    trace_.flush();
+    auto step_simplex = step.add_subkey("Simplex", Clingo::StatisticsType::Map);
+    auto accu_simplex = accu.add_subkey("Simplex", Clingo::StatisticsType::Map);
+    // Counters and timers are summed over all threads while gauges take the
+    // maximum over threads and steps.
+    auto add_sum = [&](char const *name, auto get) {
+        auto step_key = step_simplex.add_subkey(name, Clingo::StatisticsType::Value);
+        auto accu_key = accu_simplex.add_subkey(name, Clingo::StatisticsType::Value);
+        double sum = 0;
+        for (auto const &[offset, slv] : slvs_) {
+            sum += static_cast<double>(get(slv));
+        }
+        step_key.set_value(sum);
+        accu_key.set_value(accu_key.value() + sum);
+    };
+    auto add_max = [&](char const *name, auto get) {
+        auto step_key = step_simplex.add_subkey(name, Clingo::StatisticsType::Value);
+        auto accu_key = accu_simplex.add_subkey(name, Clingo::StatisticsType::Value);
+        double max = 0;
+        for (auto const &[offset, slv] : slvs_) {
+            max = std::max(max, static_cast<double>(get(slv)));
+        }
+        step_key.set_value(max);
+        accu_key.set_value(std::max(accu_key.value(), max));
+    };
+    add_sum("Pivots", [](auto const &slv) { return slv.statistics().pivots; });
+    add_sum("Bounds propagated", [](auto const &slv) { return slv.statistics().propagated_bounds; });
+    add_max("Components", [](auto const &slv) { return slv.statistics().components; });
+    add_sum("Refreshes", [](auto const &slv) { return slv.statistics().refreshes; });
+    add_sum("Nonzeros before refresh", [](auto const &slv) { return slv.statistics().refresh_nonzeros_before; });
+    add_sum("Nonzeros after refresh", [](auto const &slv) { return slv.statistics().refresh_nonzeros_after; });
+    add_sum("Columns eliminated", [](auto const &slv) { return slv.statistics().eliminated_columns; });
+    add_sum("Nonzeros eliminated", [](auto const &slv) { return slv.statistics().eliminated_nonzeros; });
+    add_sum("Conflicts", [](auto const &slv) { return slv.statistics().conflicts; });
+    add_sum("Conflict literals", [](auto const &slv) { return slv.statistics().conflict_literals; });
+    add_sum("Time solve", [](auto const &slv) { return slv.statistics().time_solve; });
+    add_sum("Time propagate", [](auto const &slv) { return slv.statistics().time_propagate; });
+#ifdef CLINGOLPX_TIMERS
+    add_sum("Time select", [](auto const &slv) { return slv.statistics().time_select; });
+    add_sum("Time pivot", [](auto const &slv) { return slv.statistics().time_pivot; });
+    add_sum("Time optimize", [](auto const &slv) { return slv.statistics().time_optimize; });
+    add_sum("Time undo", [](auto const &slv) { return slv.statistics().time_undo; });
+#endif
+    add_max("Conflict queue max", [](auto const &slv) { return slv.statistics().max_conflict_queue; });
+    add_max("Propagate queue max", [](auto const &slv) { return slv.statistics().max_propagate_queue; });
+    add_max("Nonzeros", [](auto const &slv) { return slv.tableau_size(); });
+    add_max("Coefficient bits max", [](auto const &slv) { return slv.tableau_bits(); });
+}
+
+template <typename Value, typename Matrix>
+auto Propagator<Value, Matrix>::decide(Clingo::id_t thread_id, Clingo::Assignment const &assign,
+                                      Clingo::literal_t fallback) -> Clingo::literal_t {
+    return slvs_[thread_id].second.adjust(assign, fallback);
+}
+
+template <typename Value, typename Matrix> void Propagator<Value, Matrix>::on_model(Clingo::Model const &model) {
+    if (!options_.global_objective.has_value()) {
+        return;
+    }
+    auto &slv = slvs_[model.thread_id()].second;
+    auto objective = slv.get_objective();
+    if (!objective.has_value()) {
+        return;
+    }
+    objective_state_.update(*std::move(objective));
+}
+
+template <typename Value, typename Matrix> void Propagator<Value, Matrix>::check(Clingo::PropagateControl &ctl) {
+    auto ass = ctl.assignment();
+    auto &[offset, slv] = slvs_[ctl.thread_id()];
+    if (ass.decision_level() == 0 && offset < facts_offset_) {
+        auto facts = Clingo::LiteralSpan{facts_.data() + offset, facts_offset_ - offset}; // NOLINT
+        auto res = slv.solve(ctl, facts);
+        if (record_.is_open()) {
+            record_.solve(ctl.thread_id(), 0, facts, res);
+        }
+        offset = facts_offset_;
+        // can happen in case of a top-level conflict
+        if (!res) {
+            return;
+        }
+    }
+    // Integrate level-0 bounds found by other solver threads.
+    if (share_facts_ && !slv.share_facts(ctl, fact_channel_)) {
+        return;
+    }
+    // Integrate the current objective value into the solver (if it is better).
+    if (!slv.integrate_objective(ctl, objective_state_)) {
+        return;
+    }
+    if (ass.is_total()) {
+        if (record_.is_open()) {
+            record_.check(ctl.thread_id(), ass.decision_level());
+        }
+        // Compute an optimal assignment.
+        slv.optimize();
+        // Store the current assignment in the hope that the next model can be
+        // obtained from it with a small number of pivots.
+        if (thread_options_[ctl.thread_id()].store_sat_assignment >= StoreSATAssignments::Partial) {
+            slv.store_sat_assignment();
+        }
+        // Discard bounded assignments if the objective value is unbounded.
+        if (!slv.discard_bounded(ctl)) {
+            return;
+        }
+    }
+}
+
+template <typename Value, typename Matrix>
+void Propagator<Value, Matrix>::propagate(Clingo::PropagateControl &ctl, Clingo::LiteralSpan changes) {
+    auto ass = ctl.assignment();
+    if (ass.decision_level() == 0 && ctl.thread_id() == 0) {
+        // Note to self: auxiliary variables introduced during solving cannot become facts
+        facts_.insert(facts_.end(), changes.begin(), changes.end());
+    }
+    if (ass.decision_level() == 0 && share_facts_) {
+        for (auto lit : changes) {
+            fact_channel_.publish(lit);
+        }
+    }
+    auto &[offset, slv] = slvs_[ctl.thread_id()];
+    auto res = slv.solve(ctl, changes);
+    if (record_.is_open()) {
+        record_.solve(ctl.thread_id(), ass.decision_level(), changes, res);
+    }
+    if (res && share_facts_) {
+        static_cast<void>(slv.share_facts(ctl, fact_channel_));
+    }
+}
+
+template <typename Value, typename Matrix>
+void Propagator<Value, Matrix>::undo(Clingo::PropagateControl const &ctl, Clingo::LiteralSpan changes) noexcept {
+    static_cast<void>(changes);
+    if (record_.is_open()) {
+        record_.undo(ctl.thread_id(), ctl.assignment().decision_level());
+    }
+    slvs_[ctl.thread_id()].second.undo();
+}
+
+template <typename Value, typename Matrix> void Propagator<Value, Matrix>::add_inequality(Inequality iq) {
+    if constexpr (!std::is_same_v<Value, RationalQ>) {
+        if (iq.rel == Relation::Less || iq.rel == Relation::Greater) {
+            throw std::runtime_error("strict constraints require option strict");
+        }
+    }
+    for (auto const &term : iq.lhs) {
+        if (term.var.type() == Clingo::SymbolType::Number) {
+            throw std::runtime_error("numbers must not be used as variables");
+        }
+    }
+    simplify(iq.lhs);
+    pending_iqs_.emplace_back(std::move(iq));
+}
+
+template <typename Value, typename Matrix>
+auto Propagator<Value, Matrix>::lookup_symbol(Clingo::Symbol symbol) const -> std::optional<index_t> {
+    if (auto it = var_map_.find(symbol); it != var_map_.end()) {
+        return it->second;
+    }
+    return {};
+}
+
+template <typename Value, typename Matrix>
+auto Propagator<Value, Matrix>::get_symbol(index_t i) const -> Clingo::Symbol { return var_vec_[i]; }
+
+template <typename Value, typename Matrix>
+auto Propagator<Value, Matrix>::has_value(index_t thread_id, index_t i) const -> bool {
+    static_cast<void>(thread_id);
+    return i < var_vec_.size();
+}
+
+template <typename Value, typename Matrix>
+auto Propagator<Value, Matrix>::get_value(index_t thread_id, index_t i) const -> Value {
+    return slvs_[thread_id].second.get_value(i);
+}
+
+template <typename Value, typename Matrix>
+auto Propagator<Value, Matrix>::get_objective(index_t thread_id) const -> std::optional<std::pair<Value, bool>> {
+    return slvs_[thread_id].second.get_objective();
+}
+
+template <typename Value, typename Matrix>
+auto Propagator<Value, Matrix>::n_values(index_t thread_id) const -> index_t {
+    static_cast<void>(thread_id);
+    return var_vec_.size();
+}
+
+template class Propagator<Rational, Tableau>;
+template class Propagator<RationalQ, Tableau>;
+template class Propagator<Rational, RevisedTableau>;
+template class Propagator<RationalQ, RevisedTableau>;
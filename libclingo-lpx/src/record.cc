@@ -0,0 +1,231 @@
+#include "record.hh"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr char const *MAGIC = "LPXR";
+constexpr size_t MAGIC_SIZE = 4;
+constexpr uint64_t VERSION = 1;
+
+} // namespace
+
+void RecordWriter::open(std::string const &filename, bool strict) {
+    out_.open(filename, std::ios::binary);
+    if (!out_) {
+        throw std::runtime_error("could not open record file: " + filename);
+    }
+    filename_ = filename;
+    out_.write(MAGIC, MAGIC_SIZE);
+    write_uint_(VERSION);
+    write_uint_(strict ? 1 : 0);
+}
+
+void RecordWriter::close() {
+    if (!out_.is_open()) {
+        return;
+    }
+    out_.close();
+    if (!out_) {
+        throw std::runtime_error("could not write record file: " + filename_);
+    }
+}
+
+void RecordWriter::init(size_t n_threads, std::vector<Inequality> const &inequalities, size_t offset,
+                        std::vector<Term> const &objective,
+                        std::unordered_map<Clingo::Symbol, index_t> const &variables,
+                        Clingo::Assignment const &assignment) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    out_.put(static_cast<char>(RecordTag::Init));
+    write_uint_(n_threads);
+    write_uint_(offset);
+    write_uint_(inequalities.size() - offset);
+    for (auto it = inequalities.begin() + static_cast<std::ptrdiff_t>(offset), ie = inequalities.end(); it != ie;
+         ++it) {
+        write_terms_(it->lhs, variables);
+        write_rational_(it->rhs);
+        write_uint_(static_cast<uint64_t>(it->rel));
+        write_int_(it->lit);
+    }
+    write_terms_(objective, variables);
+    std::vector<Clingo::literal_t> fixed;
+    for (auto const &x : inequalities) {
+        if (assignment.is_true(x.lit)) {
+            fixed.emplace_back(x.lit);
+        } else if (assignment.is_false(x.lit)) {
+            fixed.emplace_back(-x.lit);
+        }
+    }
+    write_uint_(fixed.size());
+    for (auto lit : fixed) {
+        write_int_(lit);
+    }
+}
+
+void RecordWriter::solve(Clingo::id_t thread_id, index_t level, Clingo::LiteralSpan literals, bool result) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    out_.put(static_cast<char>(RecordTag::Solve));
+    write_uint_(thread_id);
+    write_uint_(level);
+    write_uint_(literals.size());
+    for (auto lit : literals) {
+        write_int_(lit);
+    }
+    write_uint_(result ? 1 : 0);
+}
+
+void RecordWriter::undo(Clingo::id_t thread_id, index_t level) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    out_.put(static_cast<char>(RecordTag::Undo));
+    write_uint_(thread_id);
+    write_uint_(level);
+}
+
+void RecordWriter::check(Clingo::id_t thread_id, index_t level) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    out_.put(static_cast<char>(RecordTag::Check));
+    write_uint_(thread_id);
+    write_uint_(level);
+}
+
+void RecordWriter::write_uint_(uint64_t x) {
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+    while (x >= 0x80) {
+        out_.put(static_cast<char>((x & 0x7F) | 0x80));
+        x >>= 7U;
+    }
+    out_.put(static_cast<char>(x));
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+}
+
+void RecordWriter::write_int_(int64_t x) {
+    auto y = static_cast<uint64_t>(x);
+    write_uint_(x < 0 ? ~(y << 1U) : y << 1U);
+}
+
+void RecordWriter::write_rational_(Rational const &x) {
+    std::ostringstream oss;
+    oss << x;
+    auto str = oss.str();
+    write_uint_(str.size());
+    out_.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+void RecordWriter::write_terms_(std::vector<Term> const &terms,
+                                std::unordered_map<Clingo::Symbol, index_t> const &variables) {
+    write_uint_(terms.size());
+    for (auto const &term : terms) {
+        write_rational_(term.co);
+        write_uint_(variables.at(term.var));
+    }
+}
+
+RecordReader::RecordReader(std::string const &filename) : in_{filename, std::ios::binary} {
+    if (!in_) {
+        throw std::runtime_error("could not open record file: " + filename);
+    }
+    buf_.resize(MAGIC_SIZE);
+    in_.read(buf_.data(), MAGIC_SIZE);
+    if (!in_ || buf_ != MAGIC) {
+        throw std::runtime_error("not a record file: " + filename);
+    }
+    if (read_uint_() != VERSION) {
+        throw std::runtime_error("unsupported record version: " + filename);
+    }
+    strict_ = read_uint_() != 0;
+}
+
+auto RecordReader::read(RecordEntry &entry) -> bool {
+    auto tag = in_.get();
+    if (tag == std::ifstream::traits_type::eof()) {
+        return false;
+    }
+    entry.tag = static_cast<RecordTag>(tag);
+    entry.literals.clear();
+    switch (entry.tag) {
+        case RecordTag::Init: {
+            entry.n_threads = read_uint_();
+            entry.offset = read_uint_();
+            entry.inequalities.clear();
+            entry.inequalities.resize(read_uint_());
+            for (auto &x : entry.inequalities) {
+                read_terms_(x.lhs);
+                x.rhs = read_rational_();
+                auto rel = read_uint_();
+                if (rel > static_cast<uint64_t>(Relation::Greater)) {
+                    throw std::runtime_error("invalid relation in record file");
+                }
+                x.rel = static_cast<Relation>(rel);
+                x.lit = static_cast<Clingo::literal_t>(read_int_());
+            }
+            read_terms_(entry.objective);
+            entry.literals.resize(read_uint_());
+            for (auto &lit : entry.literals) {
+                lit = static_cast<Clingo::literal_t>(read_int_());
+            }
+            break;
+        }
+        case RecordTag::Solve: {
+            entry.thread_id = static_cast<Clingo::id_t>(read_uint_());
+            entry.level = static_cast<index_t>(read_uint_());
+            entry.literals.resize(read_uint_());
+            for (auto &lit : entry.literals) {
+                lit = static_cast<Clingo::literal_t>(read_int_());
+            }
+            entry.result = read_uint_() != 0;
+            break;
+        }
+        case RecordTag::Undo:
+        case RecordTag::Check: {
+            entry.thread_id = static_cast<Clingo::id_t>(read_uint_());
+            entry.level = static_cast<index_t>(read_uint_());
+            break;
+        }
+        default: {
+            throw std::runtime_error("invalid entry in record file");
+        }
+    }
+    return true;
+}
+
+auto RecordReader::read_uint_() -> uint64_t {
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+    uint64_t x = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        auto c = in_.get();
+        if (c == std::ifstream::traits_type::eof()) {
+            throw std::runtime_error("unexpected end of record file");
+        }
+        x |= static_cast<uint64_t>(c & 0x7F) << shift;
+        if ((c & 0x80) == 0) {
+            return x;
+        }
+    }
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+    throw std::runtime_error("invalid integer in record file");
+}
+
+auto RecordReader::read_int_() -> int64_t {
+    auto y = read_uint_();
+    return static_cast<int64_t>((y & 1U) != 0 ? ~(y >> 1U) : y >> 1U);
+}
+
+auto RecordReader::read_rational_() -> Rational {
+    buf_.resize(read_uint_());
+    in_.read(buf_.data(), static_cast<std::streamsize>(buf_.size()));
+    if (!in_) {
+        throw std::runtime_error("unexpected end of record file");
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+    return Rational{buf_, 10};
+}
+
+void RecordReader::read_terms_(std::vector<Term> &terms) {
+    terms.clear();
+    terms.resize(read_uint_());
+    for (auto &term : terms) {
+        term.co = read_rational_();
+        term.var = Clingo::Number(safe_cast<int>(read_uint_()));
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "problem.hh"
+#include "util.hh"
+
+#include <clingo.hh>
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//! The kinds of entries in a recording.
+enum class RecordTag : uint8_t {
+    //! The problem passed to the solvers when initializing a solving step.
+    Init = 1,
+    //! A call to Solver::solve() together with its result.
+    Solve = 2,
+    //! A call to Solver::undo().
+    Undo = 3,
+    //! A check on a total assignment.
+    Check = 4,
+};
+
+//! An entry of a recording.
+//!
+//! Only the members relevant for the tag are set.
+struct RecordEntry {
+    RecordTag tag{RecordTag::Init};
+    //! The number of solver threads (Init).
+    size_t n_threads{0};
+    //! The number of inequalities of previous steps (Init).
+    size_t offset{0};
+    //! The inequalities added in this step with variables given as numbers
+    //! (Init).
+    std::vector<Inequality> inequalities;
+    //! The terms of the objective function (Init).
+    std::vector<Term> objective;
+    //! The solver thread (Solve, Undo, Check).
+    Clingo::id_t thread_id{0};
+    //! The decision level of the assignment (Solve, Undo, Check).
+    index_t level{0};
+    //! The literals assigned at initialization (Init) or passed to the
+    //! solver (Solve).
+    std::vector<Clingo::literal_t> literals;
+    //! The result of the call (Solve).
+    bool result{true};
+};
+
+//! Write a recording of the calls of the propagator to the solvers to a
+//! binary file.
+//!
+//! The file starts with a header holding the magic bytes `LPXR`, a version,
+//! and whether strict constraints are supported. The entries follow, each
+//! starting with its tag. Integers are stored as variable-length integers
+//! with signed integers using zig-zag encoding and rationals as
+//! length-prefixed decimal strings. Problem variables are replaced by their
+//! indices.
+//!
+//! Entries can be added concurrently from multiple threads.
+class RecordWriter {
+  public:
+    //! Open the given file and write the header.
+    void open(std::string const &filename, bool strict);
+    //! Check whether a file is open.
+    [[nodiscard]] auto is_open() const -> bool { return out_.is_open(); }
+    //! Flush and close the file.
+    //!
+    //! Throws an exception if writing failed.
+    void close();
+
+    //! Record the inequalities starting at the given offset, the objective,
+    //! and the literals of inequalities assigned at initialization.
+    void init(size_t n_threads, std::vector<Inequality> const &inequalities, size_t offset,
+              std::vector<Term> const &objective, std::unordered_map<Clingo::Symbol, index_t> const &variables,
+              Clingo::Assignment const &assignment);
+    //! Record a call to Solver::solve().
+    void solve(Clingo::id_t thread_id, index_t level, Clingo::LiteralSpan literals, bool result);
+    //! Record a call to Solver::undo().
+    void undo(Clingo::id_t thread_id, index_t level);
+    //! Record a check on a total assignment.
+    void check(Clingo::id_t thread_id, index_t level);
+
+  private:
+    void write_uint_(uint64_t x);
+    void write_int_(int64_t x);
+    void write_rational_(Rational const &x);
+    void write_terms_(std::vector<Term> const &terms, std::unordered_map<Clingo::Symbol, index_t> const &variables);
+
+    std::mutex mutex_;
+    std::ofstream out_;
+    std::string filename_;
+};
+
+//! Read a recording written by RecordWriter.
+class RecordReader {
+  public:
+    //! Open the given file and read the header.
+    RecordReader(std::string const &filename);
+
+    //! Whether the recorded propagator supports strict constraints.
+    [[nodiscard]] auto strict() const -> bool { return strict_; }
+    //! Read the next entry.
+    //!
+    //! Returns false if the end of the file has been reached.
+    [[nodiscard]] auto read(RecordEntry &entry) -> bool;
+
+  private:
+    auto read_uint_() -> uint64_t;
+    auto read_int_() -> int64_t;
+    auto read_rational_() -> Rational;
+    void read_terms_(std::vector<Term> &terms);
+
+    std::ifstream in_;
+    std::string buf_;
+    bool strict_{false};
+};
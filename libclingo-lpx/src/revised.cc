@@ -0,0 +1,463 @@
+#include "revised.hh"
+#include "heap.hh"
+
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+
+auto RevisedTableau::get(index_t i, index_t j) const -> Rational {
+    if (i < row_var_.size() && j < col_var_.size()) {
+        auto col = column_(j);
+        auto it = std::lower_bound(col.begin(), col.end(), i, [](auto const &a, index_t b) { return a.first < b; });
+        if (it != col.end() && it->first == i) {
+            return it->second;
+        }
+    }
+    return Rational{};
+}
+
+void RevisedTableau::unsafe_get(index_t i, index_t j, Integer *&num, Integer *&den) {
+    if (cache_col_ != j) {
+        cache_ = column_(j);
+        cache_col_ = j;
+    }
+    auto it = std::lower_bound(cache_.begin(), cache_.end(), i, [](auto const &a, index_t b) { return a.first < b; });
+    assert(it != cache_.end() && it->first == i);
+    num = &it->second.num();
+    den = &it->second.den();
+}
+
+void RevisedTableau::reserve_(index_t i, index_t j) {
+    while (row_var_.size() <= i) {
+        auto r = static_cast<index_t>(row_var_.size());
+        row_var_.emplace_back(r | flag_);
+        y_pos_.emplace_back(r | flag_);
+        rows_.emplace_back();
+    }
+    while (col_var_.size() <= j) {
+        auto c = static_cast<index_t>(col_var_.size());
+        col_var_.emplace_back(c);
+        x_pos_.emplace_back(c);
+        cols_.emplace_back();
+        dropped_.emplace_back(false);
+    }
+}
+
+void RevisedTableau::set(index_t i, index_t j, Rational const &a) {
+    assert(pivots_ == 0);
+    auto set = [](SparseVec &vec, index_t k, Rational const &a) {
+        auto it = std::lower_bound(vec.begin(), vec.end(), k, [](auto const &a, index_t b) { return a.first < b; });
+        if (it != vec.end() && it->first == k) {
+            if (a == 0) {
+                vec.erase(it);
+            } else {
+                it->second = a;
+            }
+        } else if (a != 0) {
+            vec.emplace(it, k, a);
+        }
+    };
+    if (a != 0) {
+        reserve_(i, j);
+    } else if (i >= rows_.size() || j >= cols_.size()) {
+        return;
+    }
+    set(rows_[i], j, a);
+    set(cols_[j], i, a);
+    factored_ = false;
+    cache_col_ = flag_;
+}
+
+template <typename F> void RevisedTableau::for_column_(index_t var, F &&f) const {
+    if ((var & flag_) != 0) {
+        static Rational const minus_one{-1};
+        f(var ^ flag_, minus_one);
+    } else {
+        for (auto const &[r, a] : cols_[var]) {
+            f(r, a);
+        }
+    }
+}
+
+void RevisedTableau::factor_() const {
+    // The factorization performs Gaussian elimination on the rows of the
+    // basis. Columns with few non-zeros are eliminated first and the pivot
+    // row is the one with the fewest non-zeros among the candidates. This
+    // keeps the fill-in low for the sparse bases typically encountered.
+    if (factored_) {
+        return;
+    }
+    auto m = static_cast<index_t>(row_var_.size());
+    lower_.clear();
+    upper_.clear();
+    etas_.clear();
+    row_work_.resize(m);
+    pos_work_.resize(m);
+    col_work_.resize(col_var_.size());
+
+    std::vector<SparseVec> active(m);
+    std::vector<std::vector<index_t>> occurs(m);
+    std::vector<size_t> count(m, 0);
+    for (index_t pos = 0; pos < m; ++pos) {
+        for_column_(row_var_[pos], [&](index_t r, Rational const &a) {
+            active[r].emplace_back(pos, a);
+            occurs[pos].emplace_back(r);
+            ++count[pos];
+        });
+    }
+    auto cmp = [&count](index_t a, index_t b) { return count[a] < count[b] || (count[a] == count[b] && a < b); };
+    IndexedHeap<decltype(cmp)> heap{cmp};
+    for (index_t pos = 0; pos < m; ++pos) {
+        heap.push(pos);
+    }
+    auto find = [](SparseVec &vec, index_t pos) {
+        auto it = std::lower_bound(vec.begin(), vec.end(), pos, [](auto const &a, index_t b) { return a.first < b; });
+        return it != vec.end() && it->first == pos ? it : vec.end();
+    };
+
+    std::vector<bool> done(m, false);
+    SparseVec buf;
+    while (!heap.empty()) {
+        auto pos = heap.top();
+        heap.pop();
+        // select the pivot row
+        auto row = m;
+        for (auto r : occurs[pos]) {
+            if (!done[r] && find(active[r], pos) != active[r].end() &&
+                (row == m || active[r].size() < active[row].size())) {
+                row = r;
+            }
+        }
+        if (row == m) {
+            throw std::logic_error("singular basis");
+        }
+        done[row] = true;
+        auto &prow = active[row];
+        auto pit = find(prow, pos);
+        URow urow{row, pos, std::move(pit->second), {}};
+        prow.erase(pit);
+        for (auto const &[c, a] : prow) {
+            --count[c];
+            heap.update(c);
+        }
+        // eliminate the pivot column from the remaining rows
+        for (auto r : occurs[pos]) {
+            if (done[r]) {
+                continue;
+            }
+            auto &arow = active[r];
+            auto it = find(arow, pos);
+            if (it == arow.end()) {
+                continue;
+            }
+            auto factor = it->second / urow.pivot;
+            arow.erase(it);
+            auto it_a = arow.begin();
+            auto ie_a = arow.end();
+            auto it_p = prow.begin();
+            auto ie_p = prow.end();
+            while (it_a != ie_a || it_p != ie_p) {
+                if (it_p == ie_p || (it_a != ie_a && it_a->first < it_p->first)) {
+                    buf.emplace_back(std::move(*it_a++));
+                } else if (it_a == ie_a || it_p->first < it_a->first) {
+                    buf.emplace_back(it_p->first, -(factor * it_p->second));
+                    occurs[it_p->first].emplace_back(r);
+                    ++count[it_p->first];
+                    heap.update(it_p->first);
+                    ++it_p;
+                } else {
+                    auto val = std::move(it_a->second) - factor * it_p->second;
+                    if (val != 0) {
+                        buf.emplace_back(it_a->first, std::move(val));
+                    } else {
+                        --count[it_a->first];
+                        heap.update(it_a->first);
+                    }
+                    ++it_a;
+                    ++it_p;
+                }
+            }
+            std::swap(arow, buf);
+            buf.clear();
+            lower_.emplace_back(Elimination{r, row, std::move(factor)});
+        }
+        occurs[pos].clear();
+        urow.cells = std::move(prow);
+        upper_.emplace_back(std::move(urow));
+    }
+    factored_ = true;
+}
+
+auto RevisedTableau::column_(index_t j) const -> SparseVec {
+    if (dropped_[j]) {
+        return {};
+    }
+    factor_();
+    auto &b = row_work_;
+    auto &x = pos_work_;
+    // Note that the substitution with U moves all of b into x. The
+    // positions where x is non-zero are collected to avoid a dense scan.
+    auto &touched = idx_work_;
+    for_column_(col_var_[j], [&](index_t r, Rational const &a) { b[r] = a; });
+    // solve L U x = b
+    for (auto const &[target, source, factor] : lower_) {
+        if (b[source] != 0) {
+            b[target] -= factor * b[source];
+        }
+    }
+    for (auto it = upper_.rbegin(), ie = upper_.rend(); it != ie; ++it) {
+        auto &x_p = x[it->pos];
+        x_p.swap(b[it->row]);
+        for (auto const &[pos, u] : it->cells) {
+            if (x[pos] != 0) {
+                x_p -= u * x[pos];
+            }
+        }
+        if (x_p != 0) {
+            x_p /= it->pivot;
+            touched.emplace_back(it->pos);
+        }
+    }
+    // apply etas
+    for (auto const &eta : etas_) {
+        auto &x_p = x[eta.pos];
+        if (x_p != 0) {
+            x_p /= eta.pivot;
+            for (auto const &[pos, w] : eta.cells) {
+                if (x[pos] == 0) {
+                    touched.emplace_back(pos);
+                }
+                x[pos] -= w * x_p;
+            }
+        }
+    }
+    // the tableau is the negated solution
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    SparseVec ret;
+    for (auto pos : touched) {
+        if (x[pos] != 0) {
+            ret.emplace_back(pos, -x[pos]);
+            x[pos] = 0;
+        }
+    }
+    touched.clear();
+    return ret;
+}
+
+auto RevisedTableau::row_(index_t i) const -> SparseVec {
+    factor_();
+    auto &y = pos_work_;
+    auto &u = row_work_;
+    auto &t = col_work_;
+    // Note that the substitution with U moves all of y into u. The rows
+    // where u is non-zero are collected to avoid a dense scan.
+    auto &touched = idx_work_;
+    y[i] = 1;
+    // apply transposed etas in reverse order
+    for (auto it = etas_.rbegin(), ie = etas_.rend(); it != ie; ++it) {
+        auto &y_p = y[it->pos];
+        for (auto const &[pos, w] : it->cells) {
+            if (y[pos] != 0) {
+                y_p -= w * y[pos];
+            }
+        }
+        if (y_p != 0) {
+            y_p /= it->pivot;
+        }
+    }
+    // solve U^T L^T u = y
+    for (auto const &urow : upper_) {
+        auto &u_r = u[urow.row];
+        u_r.swap(y[urow.pos]);
+        if (u_r != 0) {
+            u_r /= urow.pivot;
+            for (auto const &[pos, a] : urow.cells) {
+                y[pos] -= a * u_r;
+            }
+            touched.emplace_back(urow.row);
+        }
+    }
+    for (auto it = lower_.rbegin(), ie = lower_.rend(); it != ie; ++it) {
+        if (u[it->target] != 0) {
+            if (u[it->source] == 0) {
+                touched.emplace_back(it->source);
+            }
+            u[it->source] -= it->factor * u[it->target];
+        }
+    }
+    // multiply with the non-basic columns
+    std::vector<index_t> cols;
+    auto add = [&](index_t pos, Rational val) {
+        if ((pos & flag_) == 0) {
+            if (t[pos] == 0) {
+                cols.emplace_back(pos);
+            }
+            t[pos] += val;
+        }
+    };
+    // Note that rows might have been collected twice.
+    for (auto r : touched) {
+        if (u[r] == 0) {
+            continue;
+        }
+        for (auto const &[c, a] : rows_[r]) {
+            add(x_pos_[c], -(u[r] * a));
+        }
+        add(y_pos_[r], u[r]);
+        u[r] = 0;
+    }
+    touched.clear();
+    std::sort(cols.begin(), cols.end());
+    cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+    SparseVec ret;
+    for (auto j : cols) {
+        if (dropped_[j]) {
+            t[j] = 0;
+        } else if (t[j] != 0) {
+            ret.emplace_back(j, Rational{});
+            ret.back().second.swap(t[j]);
+        }
+    }
+    return ret;
+}
+
+void RevisedTableau::pivot(index_t i, index_t j, Integer &a_ij, Integer &d_i) {
+    static_cast<void>(a_ij);
+    static_cast<void>(d_i);
+    // The new basis is obtained by replacing column i of the basis with N_j.
+    // Its inverse is E^-1 B^-1 where E is the identity matrix with column i
+    // replaced by B^-1 N_j, which is the negated column j of the tableau.
+    auto col = cache_col_ == j ? std::move(cache_) : column_(j);
+    Eta eta{i, Rational{}, {}};
+    for (auto &[k, val] : col) {
+        val.neg();
+        if (k == i) {
+            eta.pivot = std::move(val);
+        } else {
+            eta.cells.emplace_back(k, std::move(val));
+        }
+    }
+    assert(eta.pivot != 0);
+    etas_.emplace_back(std::move(eta));
+
+    auto &pos_i = (row_var_[i] & flag_) != 0 ? y_pos_[row_var_[i] ^ flag_] : x_pos_[row_var_[i]];
+    auto &pos_j = (col_var_[j] & flag_) != 0 ? y_pos_[col_var_[j] ^ flag_] : x_pos_[col_var_[j]];
+    pos_i = j;
+    pos_j = i | flag_;
+    std::swap(row_var_[i], col_var_[j]);
+
+    ++pivots_;
+    cache_col_ = flag_;
+    cache_.clear();
+    if (etas_.size() >= refactor_interval) {
+        factored_ = false;
+    }
+}
+
+void RevisedTableau::refactor() {
+    factored_ = false;
+    factor_();
+}
+
+void RevisedTableau::clear_col(index_t j) {
+    if (j < col_var_.size()) {
+        dropped_[j] = true;
+        if (cache_col_ == j) {
+            cache_col_ = flag_;
+            cache_.clear();
+        }
+    }
+}
+
+auto RevisedTableau::col_size(index_t j) const -> size_t {
+    if (j >= col_var_.size()) {
+        return 0;
+    }
+    auto var = col_var_[j];
+    if (dropped_[j]) {
+        return 0;
+    }
+    if ((var & flag_) != 0) {
+        return 1;
+    }
+    return cols_[var].size();
+}
+
+auto RevisedTableau::size() const -> size_t {
+    size_t ret = 0;
+    for (auto const &row : rows_) {
+        ret += row.size();
+    }
+    ret += lower_.size();
+    for (auto const &urow : upper_) {
+        ret += urow.cells.size() + 1;
+    }
+    for (auto const &eta : etas_) {
+        ret += eta.cells.size() + 1;
+    }
+    return ret;
+}
+
+auto RevisedTableau::bits() const -> size_t {
+    size_t n = 0;
+    auto update = [&n](Rational const &a) { n = std::max({n, a.num().bits(), a.den().bits()}); };
+    for (auto const &row : rows_) {
+        for (auto const &cell : row) {
+            update(cell.second);
+        }
+    }
+    for (auto const &elim : lower_) {
+        update(elim.factor);
+    }
+    for (auto const &urow : upper_) {
+        update(urow.pivot);
+        for (auto const &cell : urow.cells) {
+            update(cell.second);
+        }
+    }
+    for (auto const &eta : etas_) {
+        update(eta.pivot);
+        for (auto const &cell : eta.cells) {
+            update(cell.second);
+        }
+    }
+    return n;
+}
+
+auto RevisedTableau::empty() const -> bool {
+    return std::all_of(rows_.begin(), rows_.end(), [](auto const &row) { return row.empty(); });
+}
+
+void RevisedTableau::clear() {
+    rows_.clear();
+    cols_.clear();
+    row_var_.clear();
+    col_var_.clear();
+    x_pos_.clear();
+    y_pos_.clear();
+    dropped_.clear();
+    pivots_ = 0;
+    lower_.clear();
+    upper_.clear();
+    etas_.clear();
+    factored_ = false;
+    cache_col_ = flag_;
+    cache_.clear();
+}
+
+void RevisedTableau::debug(char const *indent) const {
+    size_t m = row_var_.size();
+    size_t n = col_var_.size();
+    for (size_t i = 0; i < m; ++i) {
+        std::cerr << indent;
+        std::cerr << "y_" << i << " = ";
+        for (size_t j = 0; j < n; ++j) {
+            if (j > 0) {
+                std::cerr << " + ";
+            }
+            std::cerr << get(i, j) << "*x_" << j;
+        }
+        std::cerr << "\n";
+    }
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "number.hh"
+#include "util.hh"
+
+#include <algorithm>
+#include <vector>
+
+//! A tableau represented by the original coefficients and an LU
+//! factorization of the current basis.
+//!
+//! This class offers the same interface as Tableau but never stores the
+//! tableau explicitly. Let A be the m x n matrix of coefficients given via
+//! set(). Each row i of A introduces a slack variable y_i = A_i x. This gives
+//! the system M z = 0 with M = [A | -I] and z = (x, y). Let B be the columns
+//! of M associated with basic variables and N the columns associated with
+//! non-basic variables. Then the tableau is given by T = -B^-1 N. Rows of T
+//! are obtained by solving u^T B = e_i^T (BTRAN) and columns by solving
+//! B w = N_j (FTRAN).
+//!
+//! The basis is factorized with Gaussian elimination selecting pivots with
+//! few non-zeros. Pivoting does not touch the factors but records an eta
+//! matrix. The basis is refactorized after a fixed number of pivots. Thus,
+//! the cost of a pivot depends on the fill-in of the factors and not on the
+//! fill-in of the tableau.
+//!
+//! Note that elements passed to callbacks are computed on the fly and must
+//! not be changed.
+class RevisedTableau {
+  public:
+    //! The number of pivots after which the basis is refactorized.
+    static constexpr size_t refactor_interval = 64;
+
+    //! Return A_ij.
+    //!
+    //! Runs in the time of an FTRAN operation.
+    [[nodiscard]] auto get(index_t i, index_t j) const -> Rational;
+
+    //! Return a mutable reference to A_ij assuming that A_ij != 0.
+    //!
+    //! The reference stays valid until the next call to pivot(), set(), or
+    //! clear().
+    void unsafe_get(index_t i, index_t j, Integer *&num, Integer *&den);
+
+    //! Set A_ij to value a.
+    //!
+    //! This function must only be called before pivoting.
+    void set(index_t i, index_t j, Rational const &a);
+
+    //! Call f(j, a_ij) for each element a_ij != 0 in row A_i.
+    //!
+    //! Runs in the time of a BTRAN operation plus the number of non-zeros in
+    //! the rows of the original coefficients involved.
+    template <typename F> void update_row(index_t i, F &&f) const {
+        if (i < row_var_.size()) {
+            for (auto &[j, val] : row_(i)) {
+                f(j, val.num(), val.den());
+            }
+        }
+    }
+
+    //! Call f(i, a_ij) for each element a_ij != 0 in column A^T_j.
+    //!
+    //! Runs in the time of an FTRAN operation.
+    template <typename F> void update_col(index_t j, F &&f) {
+        if (j < col_var_.size()) {
+            if (cache_col_ != j) {
+                cache_ = column_(j);
+                cache_col_ = j;
+            }
+            for (auto &[i, val] : cache_) {
+                f(i, val.num(), val.den());
+            }
+        }
+    }
+
+    //! This functions pivots row i and column j.
+    //!
+    //! The integers are ignored and only present for compatibility with
+    //! Tableau.
+    void pivot(index_t i, index_t j, Integer &a_ij, Integer &d_i);
+
+    //! Discard the eta matrices and factorize the current basis anew.
+    //!
+    //! Runs in the time of a factorization.
+    void refactor();
+
+    //! Set all elements in column A^T_j to zero.
+    //!
+    //! The column is only marked as dropped and skipped when computing rows
+    //! and columns. It must not be pivoted afterward.
+    //!
+    //! Runs in O(1).
+    void clear_col(index_t j);
+
+    //! Estimate the number of non-zero elements in column A^T_j.
+    //!
+    //! The estimate is the number of non-zero elements in the column of the
+    //! original coefficients associated with the variable of column j.
+    //!
+    //! Runs in O(1).
+    [[nodiscard]] auto col_size(index_t j) const -> size_t;
+
+    //! Get the number of non-zero elements in the coefficients and the
+    //! factorization of the basis.
+    //!
+    //! Runs in O(m).
+    [[nodiscard]] auto size() const -> size_t;
+
+    //! Get the maximum number of bits of the numerators and denominators in
+    //! the coefficients and the factorization of the basis.
+    //!
+    //! Runs in the number of non-zero elements.
+    [[nodiscard]] auto bits() const -> size_t;
+
+    //! Check if all coefficients are zero.
+    //!
+    //! Runs in O(m).
+    [[nodiscard]] auto empty() const -> bool;
+
+    //! Set all elements to zero.
+    void clear();
+
+    //! Print tableau to stderr for debugging purposes.
+    void debug(char const *indent) const;
+
+  private:
+    using SparseVec = std::vector<std::pair<index_t, Rational>>;
+
+    //! Elimination step b_target -= factor * b_source of the L factor.
+    struct Elimination {
+        index_t target;
+        index_t source;
+        Rational factor;
+    };
+    //! A row of the U factor.
+    //!
+    //! The row has a non-zero element at the pivot position. Remaining cells
+    //! refer to positions pivoted later.
+    struct URow {
+        index_t row;
+        index_t pos;
+        Rational pivot;
+        SparseVec cells;
+    };
+    //! An eta matrix recording a pivot.
+    //!
+    //! The eta matrix differs from the identity matrix in the column
+    //! associated with the pivot position.
+    struct Eta {
+        index_t pos;
+        Rational pivot;
+        SparseVec cells;
+    };
+
+    //! Marks slack variables and basic positions.
+    static constexpr index_t flag_ = index_t{1} << 31U;
+
+    //! Extend the matrix to hold A_ij.
+    void reserve_(index_t i, index_t j);
+    //! Call f(r, m_rv) for each element m_rv != 0 in column M_v.
+    template <typename F> void for_column_(index_t var, F &&f) const;
+    //! Compute LU factors of the basis (if necessary).
+    void factor_() const;
+    //! Compute row A_i.
+    auto row_(index_t i) const -> SparseVec;
+    //! Compute column A^T_j.
+    auto column_(index_t j) const -> SparseVec;
+
+    //! The rows of the original coefficients.
+    std::vector<SparseVec> rows_;
+    //! The columns of the original coefficients.
+    std::vector<SparseVec> cols_;
+    //! The variable associated with a row.
+    std::vector<index_t> row_var_;
+    //! The variable associated with a column.
+    std::vector<index_t> col_var_;
+    //! The position of original variables.
+    std::vector<index_t> x_pos_;
+    //! The position of slack variables.
+    std::vector<index_t> y_pos_;
+    //! Flags marking columns removed by clear_col().
+    std::vector<bool> dropped_;
+    //! The number of pivots since the last call to clear().
+    size_t pivots_{0};
+    // Note that the factorization is computed lazily.
+    //! The elimination steps of the L factor.
+    mutable std::vector<Elimination> lower_;
+    //! The rows of the U factor in pivot order.
+    mutable std::vector<URow> upper_;
+    //! The eta matrices recorded since the last refactorization.
+    mutable std::vector<Eta> etas_;
+    //! Whether the factorization is up to date.
+    mutable bool factored_{false};
+    //! Dense work vectors indexed by rows, positions, and columns.
+    mutable std::vector<Rational> row_work_;
+    mutable std::vector<Rational> pos_work_;
+    mutable std::vector<Rational> col_work_;
+    //! The indices of non-zero elements in the dense work vectors.
+    mutable std::vector<index_t> idx_work_;
+    //! The index of the cached column.
+    index_t cache_col_{flag_};
+    //! The last computed column to avoid repeated FTRAN operations while
+    //! pivoting.
+    SparseVec cache_;
+};
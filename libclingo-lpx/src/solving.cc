@@ -1,19 +1,23 @@
 #include "solving.hh"
-#include "parsing.hh"
 
 #include <clingo.hh>
 
+#include <algorithm>
+#include <array>
 #include <climits>
 #include <cmath>
 #include <cstddef>
 #include <exception>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
 #include <tuple>
+#include <type_traits>
 #include <unordered_set>
 #include <utility>
 
@@ -29,6 +33,26 @@ auto as_value(RationalQ const &a, Rational *b) -> Rational {
     return a.as_rational();
 }
 
+//! A configuration of the simplex algorithm used in a portfolio.
+struct PortfolioEntry {
+    SelectionHeuristic select;
+    PropagateMode propagate_mode;
+    StoreSATAssignments store_sat_assignment;
+};
+
+//! The configurations for threads 1, 2, ... used by the mixed portfolio.
+//!
+//! They combine different propagation strengths with different sign
+//! heuristics and ways to keep satisfying assignments.
+constexpr std::array<PortfolioEntry, 6> mixed_portfolio{{
+    {SelectionHeuristic::Match, PropagateMode::Changed, StoreSATAssignments::Partial},
+    {SelectionHeuristic::Conflict, PropagateMode::None, StoreSATAssignments::No},
+    {SelectionHeuristic::None, PropagateMode::Full, StoreSATAssignments::Total},
+    {SelectionHeuristic::Match, PropagateMode::None, StoreSATAssignments::Total},
+    {SelectionHeuristic::Conflict, PropagateMode::Changed, StoreSATAssignments::Partial},
+    {SelectionHeuristic::None, PropagateMode::Changed, StoreSATAssignments::No},
+}};
+
 } // namespace
 
 template <typename Value> void ObjectiveState<Value>::reset() {
@@ -43,42 +67,106 @@ template <typename Value> void ObjectiveState<Value>::update(std::pair<Value, bo
 #else
     std::unique_lock<std::mutex> lock{mutex_};
 #endif
-    if (bounded_ && (!value.second || generation_ == 0 || value.first > value_)) {
-        ++generation_;
+    auto generation = generation_.load(std::memory_order_relaxed);
+    if (bounded_ && (!value.second || generation == 0 || value.first > value_)) {
         value_ = std::move(value.first);
         bounded_ = value.second;
+        generation_.store(generation + 1, std::memory_order_release);
     }
 }
 
 template <typename Value>
 auto ObjectiveState<Value>::value(size_t &generation) -> std::optional<std::pair<Value, bool>> {
+    // The objective changes rarely. Hence, we avoid taking the lock if the
+    // generation did not change.
+    if (generation == generation_.load(std::memory_order_acquire)) {
+        return std::nullopt;
+    }
 #ifndef CLINGOLPX_NO_SHARED_MUTEX
     std::shared_lock<std::shared_mutex> lock{mutex_};
 #else
     std::unique_lock<std::mutex> lock{mutex_};
 #endif
-    if (generation != generation_) {
-        generation = generation_;
+    if (auto current = generation_.load(std::memory_order_relaxed); generation != current) {
+        generation = current;
         return std::make_pair(value_, bounded_);
     }
     return std::nullopt;
 }
 
-template <typename Value> auto bound_rel(Relation rel) -> typename Solver<Value>::BoundRelation {
+auto thread_options(Options const &options, size_t thread_id) -> Options {
+    Options ret = options;
+    if (thread_id == 0) {
+        return ret;
+    }
+    switch (options.portfolio) {
+        case Portfolio::Mixed: {
+            auto const &entry = mixed_portfolio[(thread_id - 1) % mixed_portfolio.size()];
+            ret.select = entry.select;
+            ret.propagate_mode = entry.propagate_mode;
+            ret.store_sat_assignment = entry.store_sat_assignment;
+            break;
+        }
+        case Portfolio::None: {
+            break;
+        }
+    }
+    return ret;
+}
+
+void FactChannel::reset(std::vector<Clingo::literal_t> lits) {
+    std::sort(lits.begin(), lits.end());
+    lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+    lits_ = std::move(lits);
+    published_ = std::vector<std::atomic<bool>>(lits_.size());
+    facts_ = std::vector<std::atomic<Clingo::literal_t>>(lits_.size());
+    size_ = 0;
+}
+
+void FactChannel::publish(Clingo::literal_t lit) {
+    auto it = std::lower_bound(lits_.begin(), lits_.end(), lit);
+    if (it == lits_.end() || *it != lit) {
+        return;
+    }
+    // each literal is published at most once, so the buffer cannot overflow
+    if (published_[it - lits_.begin()].exchange(true, std::memory_order_relaxed)) {
+        return;
+    }
+    auto pos = size_.fetch_add(1, std::memory_order_relaxed);
+    facts_[pos].store(lit, std::memory_order_release);
+}
+
+template <typename F> auto FactChannel::fetch(size_t &offset, F &&f) -> bool {
+    for (auto size = size_.load(std::memory_order_relaxed); offset < size;) {
+        auto lit = facts_[offset].load(std::memory_order_acquire);
+        // the slot has been claimed but the literal has not been written yet
+        if (lit == 0) {
+            break;
+        }
+        ++offset;
+        if (!f(lit)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Value, typename Matrix>
+auto bound_rel(Relation rel) -> typename Solver<Value, Matrix>::BoundRelation {
     switch (rel) {
         case Relation::Less:
         case Relation::LessEqual: {
-            return Solver<Value>::BoundRelation::LessEqual;
+            return Solver<Value, Matrix>::BoundRelation::LessEqual;
         }
         case Relation::Greater:
         case Relation::GreaterEqual: {
-            return Solver<Value>::BoundRelation::GreaterEqual;
+            return Solver<Value, Matrix>::BoundRelation::GreaterEqual;
         }
         case Relation::Equal: {
             break;
         }
     }
-    return Solver<Value>::BoundRelation::Equal;
+    return Solver<Value, Matrix>::BoundRelation::Equal;
 }
 
 template <typename Value> auto bound_val(Rational x, Relation rel) -> Value;
@@ -106,20 +194,35 @@ template <> auto bound_val<RationalQ>(Rational x, Relation rel) -> RationalQ {
     return RationalQ{std::move(x)};
 }
 
-template <typename Value> struct Solver<Value>::Prepare {
+template <typename Value, typename Matrix> struct Solver<Value, Matrix>::Prepare {
     Prepare(Solver &slv, SymbolMap const &map) : slv{slv}, map{map} {
-        slv.variables_.resize(map.size());
-        slv.n_non_basic_ = map.size();
-        for (index_t i = 0; i != slv.n_non_basic_; ++i) {
-            slv.variables_[i].index = i;
-            slv.variables_[i].reverse_index = i;
+        // When extending a solver, the variables of the previous steps keep
+        // their indices. New problem variables are appended to the vector of
+        // variables and inserted as columns in front of the rows.
+        auto n = static_cast<index_t>(slv.var_index_.size());
+        auto k = static_cast<index_t>(map.size()) - n;
+        if (k == 0) {
+            return;
+        }
+        auto m = static_cast<index_t>(slv.variables_.size());
+        slv.variables_.resize(m + k);
+        for (auto pos = m; pos-- > slv.n_non_basic_;) {
+            auto x = slv.variables_[pos].index;
+            slv.variables_[pos + k].index = x;
+            slv.variables_[x].reverse_index = pos + k;
+        }
+        for (index_t i = 0; i != k; ++i) {
+            slv.variables_[slv.n_non_basic_ + i].index = m + i;
+            slv.variables_[m + i].reverse_index = slv.n_non_basic_ + i;
+            slv.var_index_.emplace_back(m + i);
         }
+        slv.n_non_basic_ += k;
     }
 
-    auto get_non_basic(Clingo::Symbol var) -> index_t {
+    auto get_var(Clingo::Symbol var) -> index_t {
         auto jt = map.find(var);
         assert(jt != map.end());
-        return slv.variables_[jt->second].reverse_index;
+        return slv.var_index_[jt->second];
     }
 
     auto add_basic() -> index_t {
@@ -133,10 +236,46 @@ template <typename Value> struct Solver<Value>::Prepare {
     auto add_row(std::vector<Term> const &x) -> std::vector<std::pair<index_t, Rational>> {
         std::vector<std::pair<index_t, Rational>> row;
         row.reserve(x.size());
+        constant = Value{0};
 
-        // add non-basic variables
+        // Variables of previous steps might have become basic or might have
+        // been eliminated. Basic variables are replaced by their rows and
+        // eliminated ones by their values. Constants are collected separately.
+        // Note that variables keep their offsets when leaving the basis.
+        bool merge = false;
         for (auto const &term : x) {
-            row.emplace_back(get_non_basic(term.var), term.co);
+            auto &var = slv.variables_[get_var(term.var)];
+            if (var.eliminated) {
+                constant += (var.value + var.offset) * term.co;
+            } else if (var.reverse_index < slv.n_non_basic_) {
+                constant += var.offset * term.co;
+                row.emplace_back(var.reverse_index, term.co);
+            } else {
+                constant += var.offset * term.co;
+                slv.tableau_.update_row(var.reverse_index - slv.n_non_basic_,
+                                        [&](index_t j, Integer const &a_ij, Integer const &d_i) {
+                                            row.emplace_back(j, term.co * Rational{a_ij, d_i});
+                                        });
+                merge = true;
+            }
+        }
+        if (merge) {
+            std::sort(row.begin(), row.end(), [](auto const &a, auto const &b) { return a.first < b.first; });
+            auto it = row.begin();
+            for (auto jt = row.begin(), je = row.end(); jt != je;) {
+                auto kt = jt + 1;
+                for (; kt != je && kt->first == jt->first; ++kt) {
+                    jt->second += kt->second;
+                }
+                if (jt->second != 0) {
+                    if (it != jt) {
+                        *it = std::move(*jt);
+                    }
+                    ++it;
+                }
+                jt = kt;
+            }
+            row.erase(it, row.end());
         }
 
         return row;
@@ -144,9 +283,12 @@ template <typename Value> struct Solver<Value>::Prepare {
 
     Solver &slv;
     SymbolMap const &map;
+    //! The constant part of the last row.
+    Value constant;
 };
 
-template <typename Value> auto Solver<Value>::Solver::Bound::compare(Value const &value) const -> bool {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::Solver::Bound::compare(Value const &value) const -> bool {
     switch (rel) {
         case BoundRelation::Equal: {
             return value == this->value;
@@ -161,7 +303,8 @@ template <typename Value> auto Solver<Value>::Solver::Bound::compare(Value const
     return value >= this->value;
 }
 
-template <typename Value> auto Solver<Value>::Solver::Bound::conflicts(Bound const &other) const -> bool {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::Solver::Bound::conflicts(Bound const &other) const -> bool {
     switch (rel) {
         case BoundRelation::Equal: {
             return other.rel == BoundRelation::Equal ? value != other.value : other.conflicts(*this);
@@ -176,8 +319,8 @@ template <typename Value> auto Solver<Value>::Solver::Bound::conflicts(Bound con
     return value >= this->value;
 }
 
-template <typename Value>
-auto Solver<Value>::Variable::update_upper(Solver &s, Clingo::Assignment ass, Bound const &bound) -> bool {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::Variable::update_upper(Solver &s, Clingo::Assignment ass, Bound const &bound) -> bool {
     if (!has_upper() || bound.value < upper()) {
         if (!has_upper() || ass.level(upper_bound->lit) < ass.decision_level()) {
             s.bound_trail_.emplace_back(bound.variable, BoundRelation::LessEqual, upper_bound);
@@ -187,8 +330,8 @@ auto Solver<Value>::Variable::update_upper(Solver &s, Clingo::Assignment ass, Bo
     return !has_lower() || lower() <= upper();
 }
 
-template <typename Value>
-auto Solver<Value>::Variable::update_lower(Solver &s, Clingo::Assignment ass, Bound const &bound) -> bool {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::Variable::update_lower(Solver &s, Clingo::Assignment ass, Bound const &bound) -> bool {
     if (!has_lower() || bound.value > lower()) {
         if (!has_lower() || ass.level(lower_bound->lit) < ass.decision_level()) {
             if (upper_bound != &bound) {
@@ -203,8 +346,8 @@ auto Solver<Value>::Variable::update_lower(Solver &s, Clingo::Assignment ass, Bo
     return !has_upper() || lower() <= upper();
 }
 
-template <typename Value>
-auto Solver<Value>::Variable::update(Solver &s, Clingo::Assignment ass, Bound const &bound) -> bool {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::Variable::update(Solver &s, Clingo::Assignment ass, Bound const &bound) -> bool {
     switch (bound.rel) {
         case BoundRelation::LessEqual: {
             return update_upper(s, ass, bound);
@@ -219,10 +362,22 @@ auto Solver<Value>::Variable::update(Solver &s, Clingo::Assignment ass, Bound co
     return update_upper(s, ass, bound) && update_lower(s, ass, bound);
 }
 
-template <typename Value> void Solver<Value>::Variable::set_value(Solver &s, index_t lvl, Value const &val, bool add) {
+template <typename Value, typename Matrix>
+void Solver<Value, Matrix>::Variable::set_value(Solver &s, index_t lvl, Value const &val, bool add) {
     // We can always assume that the assignment on a previous level was satisfying.
     // Thus, we simply store the old values to be able to restore them when backtracking.
-    if (lvl != level) {
+    //
+    // When partially storing satisfying assignments, backtracking always
+    // restores the last satisfying assignment. Then it suffices to save the
+    // old value once. Note that the assignment reuses the memory of the saved
+    // value and that restoring merely swaps the values.
+    if (s.options_.store_sat_assignment == StoreSATAssignments::Partial) {
+        if (!dirty) {
+            dirty = true;
+            saved = value;
+            s.dirty_.emplace_back(this - s.variables_.data());
+        }
+    } else if (lvl != level) {
         s.assignment_trail_.emplace_back(level, this - s.variables_.data(), value);
         level = lvl;
     }
@@ -233,65 +388,87 @@ template <typename Value> void Solver<Value>::Variable::set_value(Solver &s, ind
     }
 }
 
-template <typename Value> auto Solver<Value>::Variable::has_conflict() const -> bool {
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::Variable::has_conflict() const -> bool {
     return (has_lower() && value < lower()) || (has_upper() && value > upper());
 }
 
 void Statistics::reset() { *this = {}; }
 
-template <typename Value> Solver<Value>::Solver(Options const &options) : options_{options} {}
+template <typename Value, typename Matrix> Solver<Value, Matrix>::Solver(Options const &options, TraceBuffer *trace)
+    : options_{options}, trace_{trace} {}
 
-template <typename Value> auto Solver<Value>::basic_(index_t i) -> typename Solver<Value>::Variable & {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::basic_(index_t i) -> typename Solver<Value, Matrix>::Variable & {
     assert(i < n_basic_);
     return variables_[variables_[i + n_non_basic_].index];
 }
 
-template <typename Value> auto Solver<Value>::non_basic_(index_t j) -> typename Solver<Value>::Variable & {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::non_basic_(index_t j) -> typename Solver<Value, Matrix>::Variable & {
     assert(j < n_non_basic_);
     return variables_[variables_[j].index];
 }
 
-template <typename Value> void Solver<Value>::enqueue_(index_t i) {
+template <typename Value, typename Matrix> void Solver<Value, Matrix>::enqueue_(index_t i) {
     assert(i < n_basic_);
     auto ii = variables_[i + n_non_basic_].index;
     auto &xi = variables_[ii];
-    if (!xi.queued && xi.has_conflict()) {
-        conflicts_.emplace(ii);
-        xi.queued = true;
+    if (xi.has_conflict()) {
+        conflicts_.push(ii);
+        statistics_.max_conflict_queue = std::max(statistics_.max_conflict_queue, conflicts_.size());
     }
     // Note that this explicitely marks the row not the variable to propagate.
     if (options_.propagate_mode == PropagateMode::Changed && !variables_[i].propagate) {
         variables_[i].propagate = true;
         propagate_queue_.emplace_back(i);
+        statistics_.max_propagate_queue = std::max(statistics_.max_propagate_queue, propagate_queue_.size());
     }
 }
 
-template <typename Value> auto Solver<Value>::get_value(index_t i) const -> Value { return variables_[i].value; }
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::get_value(index_t i) const -> Value {
+    return value_(var_index_[i]);
+}
+
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::value_(index_t x) const -> Value {
+    if (dormant_(x)) {
+        return row_value_(variables_[x].reverse_index - n_non_basic_) + variables_[x].offset;
+    }
+    return variables_[x].value + variables_[x].offset;
+}
 
-template <typename Value> auto Solver<Value>::get_objective() const -> std::optional<std::pair<Value, bool>> {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::get_objective() const -> std::optional<std::pair<Value, bool>> {
     if (objective_) {
-        return std::make_pair(variables_[objective_.var].value, objective_.bounded);
+        return std::make_pair(value_(objective_.var), objective_.bounded);
     }
     return std::nullopt;
 }
 
-template <typename Value>
-auto Solver<Value>::prepare(Clingo::PropagateInit &init, SymbolMap const &symbols,
-                            std::vector<Inequality> const &inequalities, std::vector<Term> const &objective,
-                            bool master) -> bool {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::add_inequalities_(Clingo::PropagateInit &init, Prepare &prep,
+                                              std::vector<Inequality> const &inequalities, size_t offset,
+                                              bool master) -> bool {
     auto ass = init.assignment();
 
-    Prepare prep{*this, symbols};
-    for (auto const &x : inequalities) {
+    std::vector<Bound *> added;
+    auto add_bound = [&](Clingo::literal_t lit, Value value, index_t var, Relation rel) {
+        // Bounds are given w.r.t. the original problem and have to be
+        // shifted by the offset of the variable (see eliminate_).
+        value -= variables_[var].offset;
+        auto it = bounds_.emplace(lit, Bound{std::move(value), var, lit, bound_rel<Value, Matrix>(rel)});
+        variables_[var].bounds.emplace_back(&it->second);
+        added.emplace_back(&it->second);
+    };
+    for (auto it = inequalities.begin() + static_cast<std::ptrdiff_t>(offset), ie = inequalities.end(); it != ie;
+         ++it) {
+        auto const &x = *it;
         if (ass.is_false(x.lit)) {
             continue;
         }
 
-        // transform inequality into row suitable for tableau
-        auto row = prep.add_row(x.lhs);
-
         // check bound against 0
-        if (row.empty()) {
+        if (x.lhs.empty()) {
             if (!master) {
                 continue;
             }
@@ -328,24 +505,61 @@ auto Solver<Value>::prepare(Clingo::PropagateInit &init, SymbolMap const &symbol
                 }
             }
         }
-        // add a bound to a non-basic variable
-        else if (row.size() == 1) {
-            auto const &[j, v] = row.front();
-            auto rel = v < 0 ? invert(x.rel) : x.rel;
-            bounds_.emplace(x.lit,
-                            Bound{bound_val<Value>(x.rhs / v, rel), variables_[j].index, x.lit, bound_rel<Value>(rel)});
+        // add a bound to a problem variable
+        else if (x.lhs.size() == 1) {
+            auto const &term = x.lhs.front();
+            auto rel = term.co < 0 ? invert(x.rel) : x.rel;
+            add_bound(x.lit, bound_val<Value>(x.rhs / term.co, rel), prep.get_var(term.var), rel);
         }
         // add an inequality
         else {
+            // transform inequality into row suitable for tableau
+            auto row = prep.add_row(x.lhs);
             auto i = prep.add_basic();
-            bounds_.emplace(x.lit, Bound{bound_val<Value>(x.rhs, x.rel), static_cast<index_t>(variables_.size() - 1),
-                                         x.lit, bound_rel<Value>(x.rel)});
+            auto var = static_cast<index_t>(variables_.size() - 1);
+            variables_[var].offset = std::move(prep.constant);
+            add_bound(x.lit, bound_val<Value>(x.rhs, x.rel), var, x.rel);
             for (auto const &[j, v] : row) {
                 tableau_.set(i, j, v);
             }
         }
     }
 
+    // Add binary clauses for the following bounds:
+    //
+    //   x >= u implies not x <= l for all l < u.
+    //
+    // Only pairs involving at least one of the added bounds are considered.
+    if (options_.propagate_conflicts && master) {
+        for (auto const *bb : added) {
+            for (auto const *ba : variables_[bb->variable].bounds) {
+                if (ba == bb) {
+                    break;
+                }
+                if (ba->lit != -bb->lit && !ass.is_false(bb->lit) && ba->conflicts(*bb)) {
+                    conflict_clause_.clear();
+                    conflict_clause_.emplace_back(-ba->lit);
+                    conflict_clause_.emplace_back(-bb->lit);
+                    if (!init.add_clause(conflict_clause_) || !init.propagate()) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::prepare(Clingo::PropagateInit &init, SymbolMap const &symbols,
+                            std::vector<Inequality> const &inequalities, std::vector<Term> const &objective,
+                            bool master) -> bool {
+    Prepare prep{*this, symbols};
+    if (!add_inequalities_(init, prep, inequalities, 0, master)) {
+        return false;
+    }
+
     // add objective function to tableau
     if (!objective.empty()) {
         objective_.active = true;
@@ -363,43 +577,125 @@ auto Solver<Value>::prepare(Clingo::PropagateInit &init, SymbolMap const &symbol
         objective_.var = add_row();
     }
 
+    init_components_();
+
+    if (options_.refresh_factor > 0 || options_.refresh_restart) {
+        initial_ = tableau_;
+        refresh_size_ = tableau_.size();
+        refresh_bits_ = tableau_.bits();
+    }
+
     for (size_t i = 0; i < n_basic_; ++i) {
         enqueue_(i);
     }
 
-    for (auto const &[lit, bound] : bounds_) {
-        variables_[bound.variable].bounds.emplace_back(&bound);
+    assert_extra(check_tableau_());
+    assert_extra(check_basic_());
+    assert_extra(check_non_basic_());
+
+    return true;
+}
+
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::extensible() const -> bool {
+    // The revised engine and the initial tableau used for refreshing store
+    // coefficients w.r.t. the original columns, which would have to be
+    // tracked separately. The bound on the objective is a literal local to
+    // the previous step.
+    return std::is_same_v<Matrix, Tableau> && options_.refresh_factor == 0 && !options_.refresh_restart &&
+           objective_.bound == nullptr;
+}
+
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::extend(Clingo::PropagateInit &init, SymbolMap const &symbols,
+                                   std::vector<Inequality> const &inequalities, size_t offset, bool master)
+    -> bool {
+    // The solver is on decision level 0 here. Its basis, assignment, and
+    // level-0 bounds stay valid because facts of previous steps cannot be
+    // retracted. New variables are non-basic with value zero and new rows
+    // are expressed in terms of the current basis.
+    assert(extensible());
+    statistics_.reset();
+    objective_.generation = 0;
+    objective_.discard_bounded = false;
+    objective_.bounded = true;
+    facts_.clear();
+    facts_offset_ = 0;
+    sat_values_.clear();
+
+    auto n_basic = n_basic_;
+    Prepare prep{*this, symbols};
+    if (!add_inequalities_(init, prep, inequalities, offset, master)) {
+        return false;
     }
+
+    init_components_();
+
+    for (auto i = n_basic; i < n_basic_; ++i) {
+        basic_(i).value = row_value_(i);
+        enqueue_(i);
+    }
+
     assert_extra(check_tableau_());
     assert_extra(check_basic_());
     assert_extra(check_non_basic_());
 
-    // Add binary clauses for the following bounds:
-    //
-    //   x >= u implies not x <= l for all l < u.
-    if (options_.propagate_conflicts && master) {
-        for (auto const &var : variables_) {
-            for (auto it_a = var.bounds.begin(), ie = var.bounds.end(); it_a != ie; ++it_a) {
-                auto const &ba = **it_a;
-                for (auto it_b = it_a + 1; it_b != ie; ++it_b) {
-                    auto const &bb = **it_b;
-                    if (ba.lit != -bb.lit && !ass.is_false(bb.lit) && ba.conflicts(bb)) {
-                        conflict_clause_.clear();
-                        conflict_clause_.emplace_back(-ba.lit);
-                        conflict_clause_.emplace_back(-bb.lit);
-                        if (!init.add_clause(conflict_clause_) || !init.propagate()) {
-                            return false;
-                        }
-                    }
-                }
-            }
+    return true;
+}
+
+template <typename Value, typename Matrix> void Solver<Value, Matrix>::init_components_() {
+    components_.clear();
+    changed_components_.clear();
+    // Rows and columns are joined using a union-find structure over their
+    // positions. Components are only created for sets containing a row.
+    auto n = n_non_basic_;
+    std::vector<index_t> parent(variables_.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](index_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+    for (index_t i = 0; i < n_basic_; ++i) {
+        tableau_.update_row(i, [&](index_t j, Integer const &a_ij, Integer const &d_i) {
+            static_cast<void>(a_ij);
+            static_cast<void>(d_i);
+            parent[find(j)] = find(i + n);
+        });
+    }
+    auto none = std::numeric_limits<index_t>::max();
+    std::vector<index_t> ids(variables_.size(), none);
+    for (index_t i = 0; i < n_basic_; ++i) {
+        auto &id = ids[find(i + n)];
+        if (id == none) {
+            id = static_cast<index_t>(components_.size());
+            components_.emplace_back();
         }
     }
+    component_.resize(variables_.size());
+    for (index_t k = 0; k < variables_.size(); ++k) {
+        component_[k] = ids[find(k)];
+    }
+    for (index_t i = 0; i < n_basic_; ++i) {
+        components_[component_[i + n]].rows.emplace_back(i);
+    }
+    for (index_t c = 0; c < components_.size(); ++c) {
+        components_[c].changed = true;
+        changed_components_.emplace_back(c);
+    }
+    statistics_.components = components_.size();
+}
 
-    return true;
+template <typename Value, typename Matrix> void Solver<Value, Matrix>::touch_(index_t x) {
+    auto c = component_[variables_[x].reverse_index];
+    if (c != std::numeric_limits<index_t>::max() && !components_[c].changed) {
+        components_[c].changed = true;
+        changed_components_.emplace_back(c);
+    }
 }
 
-template <typename Value> void Solver<Value>::debug_() {
+template <typename Value, typename Matrix> void Solver<Value, Matrix>::debug_() {
     std::cerr << "tableau:" << std::endl;
     tableau_.debug("  ");
     if (objective_) {
@@ -443,7 +739,9 @@ template <typename Value> void Solver<Value>::debug_() {
     }
 }
 
-template <typename Value> void Solver<Value>::optimize() {
+template <typename Value, typename Matrix> void Solver<Value, Matrix>::optimize() {
+    CLINGOLPX_TIMER_SCOPE(statistics_.time_optimize);
+    CLINGOLPX_TRACE_SCOPE(trace_, "optimize");
     assert(!objective_ || variables_[objective_.var].reverse_index >= n_non_basic_);
     // First, we select an entering variable x_e among the non-basic variables
     // corresponding to a non-zero coefficient a_ze in the objective function
@@ -580,7 +878,11 @@ template <typename Value> void Solver<Value>::optimize() {
     }
 }
 
-template <typename Value> void Solver<Value>::store_sat_assignment() {
+template <typename Value, typename Matrix> void Solver<Value, Matrix>::store_sat_assignment() {
+    for (auto index : dirty_) {
+        variables_[index].dirty = false;
+    }
+    dirty_.clear();
     for (auto &[level, index, number] : assignment_trail_) {
         variables_[index].level = 0;
     }
@@ -592,77 +894,154 @@ template <typename Value> void Solver<Value>::store_sat_assignment() {
         }
     }
     assignment_trail_.clear();
+    assert_extra(check_store_());
 }
 
-template <typename Value> auto Solver<Value>::update_bound_(Clingo::PropagateControl &ctl, Bound const &bound) -> bool {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::update_bound_(Clingo::PropagateControl &ctl, Bound const &bound) -> bool {
     auto ass = ctl.assignment();
     auto &x = variables_[bound.variable];
+    touch_(bound.variable);
+    auto dormant = dormant_(bound.variable);
     if (!x.update(*this, ass, bound)) {
         conflict_clause_.clear();
         conflict_clause_.emplace_back(-x.upper_bound->lit);
         conflict_clause_.emplace_back(-x.lower_bound->lit);
+        ++statistics_.conflicts;
+        statistics_.conflict_literals += conflict_clause_.size();
         ctl.add_clause(conflict_clause_);
         return false;
     }
+    if (options_.eliminate_fixed && ass.decision_level() == 0 && x.has_lower() && x.has_upper() &&
+        x.lower() == x.upper()) {
+        fixed_.emplace_back(bound.variable);
+    }
     if (x.reverse_index < n_non_basic_) {
-        if (x.has_lower() && x.value < x.lower()) {
-            update_(ass.decision_level(), x.reverse_index, x.lower());
-        } else if (x.has_upper() && x.value > x.upper()) {
-            update_(ass.decision_level(), x.reverse_index, x.upper());
-        }
+        defer_update_(bound.variable);
     } else {
-        enqueue_(x.reverse_index - n_non_basic_);
+        auto i = x.reverse_index - n_non_basic_;
+        if (dormant) {
+            // The value of a dormant variable is outdated. If the variable
+            // leaves the basis later, backtracking would restore the outdated
+            // value. Hence, the value to restore is computed, too.
+            if (!x.dirty) {
+                x.dirty = true;
+                x.saved = saved_row_value_(i);
+                dirty_.emplace_back(bound.variable);
+            }
+            x.set_value(*this, ass.decision_level(), row_value_(i), false);
+        }
+        enqueue_(i);
     }
     return true;
 }
 
-template <typename Value> auto Solver<Value>::assert_bound_(Clingo::PropagateControl &ctl, Value value) -> bool {
-    // Adds a new bound associated with a new literal that is made true by a
-    // unit clause. This ensures that the solver takes care of backtracking and
-    // reasserting the literal.
-    auto lit = ctl.add_literal();
-    ctl.add_watch(lit);
-    bounds_.emplace(lit, Bound{std::move(value), objective_.bound_var, lit, BoundRelation::GreaterEqual});
-    conflict_clause_.clear();
-    conflict_clause_.emplace_back(lit);
-    return ctl.add_clause(conflict_clause_) && ctl.propagate();
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::assert_bound_(Clingo::PropagateControl &ctl, Value value) -> bool {
+    // The first call adds a bound associated with a new literal that is made
+    // true by a unit clause. Subsequent calls tighten this bound in place
+    // instead of introducing further literals. This is sound because the
+    // literal is a fact and the bound only gets stronger; clauses involving
+    // the literal stay valid. Since backtracking does not restore the
+    // previous bound, the assignment has to be repaired lazily (see
+    // repair_objective_).
+    //
+    // Values are given w.r.t. the original problem and have to be shifted by
+    // the constants substituted for eliminated variables.
+    value -= variables_[objective_.bound_var].offset;
+    if (objective_.bound == nullptr) {
+        auto lit = ctl.add_literal();
+        ctl.add_watch(lit);
+        auto it = bounds_.emplace(lit, Bound{std::move(value), objective_.bound_var, lit, BoundRelation::GreaterEqual});
+        objective_.bound = &it->second;
+        conflict_clause_.clear();
+        conflict_clause_.emplace_back(lit);
+        return ctl.add_clause(conflict_clause_) && ctl.propagate();
+    }
+    if (objective_.bound->value < value) {
+        objective_.bound->value = std::move(value);
+        touch_(objective_.bound_var);
+    }
+    return !objective_violated_() || solve(ctl, {});
 }
 
-template <typename Value>
-auto Solver<Value>::integrate_objective(Clingo::PropagateControl &ctl, ObjectiveState<Value> &state) -> bool {
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::objective_violated_() const -> bool {
+    if (objective_.bound == nullptr) {
+        return false;
+    }
+    auto const &x = variables_[objective_.bound_var];
+    return x.has_lower() && x.value < x.lower();
+}
+
+template <typename Value, typename Matrix> void Solver<Value, Matrix>::repair_objective_() {
+    if (!objective_violated_()) {
+        return;
+    }
+    auto &x = variables_[objective_.bound_var];
+    if (x.reverse_index < n_non_basic_) {
+        defer_update_(objective_.bound_var);
+    } else {
+        enqueue_(x.reverse_index - n_non_basic_);
+    }
+}
+
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::integrate_objective(Clingo::PropagateControl &ctl, ObjectiveState<Value> &state) -> bool {
     // Here we discard bounded solutions by asserting that the objective value
     // is greater than the current bound + an epsilon value taken from the
     // configuration.
-    //
-    // Note that this function associates many bounds with the objective
-    // variable. In principle, it would be nice to remove the old ones. I think
-    // that clasp also offers a method to pop a literal introduced during
-    // search.
     if (!options_.global_objective.has_value()) {
         return true;
     }
     auto value = state.value(objective_.generation);
-    if (!value.has_value()) {
-        return true;
-    }
-    if (!value->second) {
-        objective_.discard_bounded = true;
-        return true;
+    if (value.has_value()) {
+        if (!value->second) {
+            objective_.discard_bounded = true;
+            return true;
+        }
+        return assert_bound_(
+            ctl, std::move(value->first) + as_value(*options_.global_objective, static_cast<Value *>(nullptr)));
     }
-    return assert_bound_(ctl,
-                         std::move(value->first) + as_value(*options_.global_objective, static_cast<Value *>(nullptr)));
+    // The bound might have been tightened on a higher decision level. Then
+    // the assignment restored by backtracking might violate it.
+    return !objective_violated_() || solve(ctl, {});
 }
 
-template <typename Value> auto Solver<Value>::discard_bounded(Clingo::PropagateControl &ctl) -> bool {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::discard_bounded(Clingo::PropagateControl &ctl) -> bool {
     // Here we discard bounded solutions by asserting that the objective
     // is greater than the current optimal objective.
     if (!objective_ || !options_.global_objective.has_value() || !objective_.bounded || !objective_.discard_bounded) {
         return true;
     }
-    return assert_bound_(ctl, variables_[objective_.var].value + 1);
+    return assert_bound_(ctl, value_(objective_.var) + 1);
+}
+
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::share_facts(Clingo::PropagateControl &ctl, FactChannel &channel) -> bool {
+    // Level-0 literals are consequences of the problem and can be added as
+    // unit clauses to all solvers. Note that only literals associated with
+    // bounds are shared. Auxiliary literals introduced while solving are
+    // local to a solver and ignored by the channel.
+    for (auto lit : facts_) {
+        channel.publish(lit);
+    }
+    facts_.clear();
+    auto ass = ctl.assignment();
+    return channel.fetch(facts_offset_, [&, this](Clingo::literal_t lit) {
+        if (ass.is_fixed(lit) && ass.is_true(lit)) {
+            return true;
+        }
+        conflict_clause_.clear();
+        conflict_clause_.emplace_back(lit);
+        return ctl.add_clause(conflict_clause_) && ctl.propagate();
+    });
 }
 
-template <typename Value> auto Solver<Value>::solve(Clingo::PropagateControl &ctl, Clingo::LiteralSpan lits) -> bool {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::solve(Clingo::PropagateControl &ctl, Clingo::LiteralSpan lits) -> bool {
+    Timer timer{statistics_.time_solve};
+    CLINGOLPX_TRACE_SCOPE(trace_, "solve");
     index_t i{0};
     index_t j{0};
     Value const *v{nullptr};
@@ -670,46 +1049,73 @@ template <typename Value> auto Solver<Value>::solve(Clingo::PropagateControl &ct
     auto ass = ctl.assignment();
     auto level = ass.decision_level();
 
+    if (refresh_due_(level)) {
+        refresh_();
+    }
+
     if (trail_offset_.empty() || trail_offset_.back().level < level) {
         trail_offset_.emplace_back(TrailOffset{level, static_cast<index_t>(bound_trail_.size()),
                                                static_cast<index_t>(assignment_trail_.size())});
     }
 
+    repair_objective_();
+
     for (auto lit : lits) {
         for (auto it = bounds_.find(lit), ie = bounds_.end(); it != ie && it->first == lit; ++it) {
             auto const &[lit_a, bound_a] = *it;
             assert(lit == lit_a);
             if (!update_bound_(ctl, bound_a)) {
+                for (auto x : pending_) {
+                    variables_[x].pending = false;
+                }
+                pending_.clear();
                 return false;
             }
         }
     }
+    flush_updates_(level);
 
     assert_extra(check_tableau_());
     assert_extra(check_basic_());
     assert_extra(check_non_basic_());
 
+    // The sparse entering rule does not guarantee termination. Hence, we
+    // fall back to Bland's rule after a number of pivots linear in the
+    // number of variables.
+    size_t budget = options_.entering == EnteringRule::Markowitz ? variables_.size() : 0;
     while (true) {
-        switch (select_(i, j, v)) {
+        switch (select_(i, j, v, budget == 0)) {
             case State::Satisfiable: {
                 if (options_.store_sat_assignment == StoreSATAssignments::Partial) {
                     store_sat_assignment();
                 }
+                if (level == 0 && !fixed_.empty()) {
+                    eliminate_();
+                }
                 return propagate_(ctl);
             }
             case State::Unsatisfiable: {
+                ++statistics_.conflicts;
+                statistics_.conflict_literals += conflict_clause_.size();
                 ctl.add_clause(conflict_clause_);
                 return false;
             }
             case State::Unknown: {
                 assert(v != nullptr);
                 pivot_(level, i, j, *v); // NOLINT
+                if (budget > 0) {
+                    --budget;
+                }
             }
         }
     }
 }
 
-template <typename Value> auto Solver<Value>::propagate_(Clingo::PropagateControl &ctl) -> bool {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::propagate_(Clingo::PropagateControl &ctl) -> bool {
+    Timer timer{statistics_.time_propagate};
+    CLINGOLPX_TRACE_SCOPE(trace_, "propagate");
+
     // In principle we could also propgate more bounds (see clingcon). This
     // would very likely be too expensive.
     //
@@ -775,6 +1181,10 @@ template <typename Value> auto Solver<Value>::propagate_(Clingo::PropagateContro
             bool ret = ctl.add_clause(clause) && ctl.propagate();
             clause.pop_back();
             ++statistics_.propagated_bounds;
+            // the literal is a fact if it has been propagated on level 0
+            if (ret && options_.share_facts && ass.decision_level() == 0) {
+                facts_.emplace_back(-bound.lit);
+            }
             return ret;
         };
         // propagate the bounds
@@ -809,16 +1219,25 @@ template <typename Value> auto Solver<Value>::propagate_(Clingo::PropagateContro
             }
         }
     } else {
-        for (index_t i = 0; i < n_basic_; ++i) {
-            if (!propagate_row(i)) {
-                return false;
+        // Only components whose bounds or rows changed since they have been
+        // propagated last can give rise to new bounds.
+        while (!changed_components_.empty()) {
+            auto &component = components_[changed_components_.back()];
+            for (auto i : component.rows) {
+                if (!propagate_row(i)) {
+                    return false;
+                }
             }
+            component.changed = false;
+            changed_components_.pop_back();
         }
     }
     return true;
 }
 
-template <typename Value> void Solver<Value>::undo() {
+template <typename Value, typename Matrix> void Solver<Value, Matrix>::undo() {
+    CLINGOLPX_TIMER_SCOPE(statistics_.time_undo);
+    CLINGOLPX_TRACE_SCOPE(trace_, "undo");
     try {
         // this function restores the last satisfying assignment
         auto &offset = trail_offset_.back();
@@ -826,6 +1245,7 @@ template <typename Value> void Solver<Value>::undo() {
         // undo bound updates
         for (auto it = bound_trail_.begin() + offset.bound, ie = bound_trail_.end(); it != ie; ++it) {
             auto [var, rel, bound] = *it;
+            touch_(var);
             switch (rel) {
                 case BoundRelation::LessEqual: {
                     variables_[var].upper_bound = bound;
@@ -851,48 +1271,60 @@ template <typename Value> void Solver<Value>::undo() {
             variables_[index].value.swap(number);
         }
         assignment_trail_.resize(offset.assignment);
+        for (auto index : dirty_) {
+            auto &x = variables_[index];
+            x.value.swap(x.saved);
+            x.dirty = false;
+        }
+        dirty_.clear();
+        assert_extra(check_restore_());
 
         // empty queue
-        for (; !conflicts_.empty(); conflicts_.pop()) {
-            variables_[conflicts_.top()].queued = false;
-        }
+        conflicts_.clear();
 
         trail_offset_.pop_back();
 
-        assert_extra(check_solution_());
+        // the bound on the objective is not restored and repaired lazily
+        assert_extra(objective_violated_() || check_solution_());
     } catch (...) {
         std::terminate();
     }
 }
 
-template <typename Value> auto Solver<Value>::statistics() const -> Statistics const & { return statistics_; }
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::statistics() const -> Statistics const & { return statistics_; }
+
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::tableau_size() const -> size_t {
+    return tableau_.size();
+}
+
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::tableau_bits() const -> size_t {
+    return tableau_.bits();
+}
 
-template <typename Value> auto Solver<Value>::check_tableau_() -> bool {
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::check_tableau_() -> bool {
     for (index_t i{0}; i < n_basic_; ++i) {
-        Value v_i;
-        tableau_.update_row(
-            i, [&](index_t j, Integer const &a_ij, Integer d_i) { v_i += non_basic_(j).value * a_ij / d_i; });
-        if (v_i != basic_(i).value) {
+        if (!dormant_(variables_[i + n_non_basic_].index) && row_value_(i) != basic_(i).value) {
             return false;
         }
     }
     return true;
 }
 
-template <typename Value> auto Solver<Value>::check_basic_() -> bool {
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::check_basic_() -> bool {
     for (index_t i = 0; i < n_basic_; ++i) {
         auto &xi = basic_(i);
-        if (xi.has_lower() && xi.value < xi.lower() && !xi.queued) {
+        if (xi.has_lower() && xi.value < xi.lower() && !conflicts_.contains(variables_[i + n_non_basic_].index)) {
             return false;
         }
-        if (xi.has_upper() && xi.value > xi.upper() && !xi.queued) {
+        if (xi.has_upper() && xi.value > xi.upper() && !conflicts_.contains(variables_[i + n_non_basic_].index)) {
             return false;
         }
     }
     return true;
 }
 
-template <typename Value> auto Solver<Value>::check_non_basic_() -> bool {
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::check_non_basic_() -> bool {
     for (index_t j = 0; j < n_non_basic_; ++j) {
         auto &xj = non_basic_(j);
         if (xj.has_lower() && xj.value < xj.lower()) {
@@ -905,7 +1337,7 @@ template <typename Value> auto Solver<Value>::check_non_basic_() -> bool {
     return true;
 }
 
-template <typename Value> auto Solver<Value>::check_solution_() -> bool {
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::check_solution_() -> bool {
     for (auto &x : variables_) {
         if (x.has_lower() && x.lower() > x.value) {
             return false;
@@ -917,16 +1349,254 @@ template <typename Value> auto Solver<Value>::check_solution_() -> bool {
     return check_tableau_() && check_basic_();
 }
 
-template <typename Value> void Solver<Value>::update_(index_t level, index_t j, Value v) {
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::check_store_() -> bool {
+    sat_values_.clear();
+    if (options_.store_sat_assignment == StoreSATAssignments::Partial) {
+        for (index_t x = 0; x < variables_.size(); ++x) {
+            sat_values_.emplace_back(value_(x));
+        }
+    }
+    return true;
+}
+
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::check_restore_() const -> bool {
+    // Note that the values of dormant variables are computed from their
+    // rows and that eliminating columns does not change the values.
+    for (index_t x = 0; x < sat_values_.size(); ++x) {
+        if (value_(x) != sat_values_[x]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::refresh_due_(index_t level) -> bool {
+    if (statistics_.pivots == refresh_pivots_) {
+        return false;
+    }
+    // The search starts a new descent from decision level 0.
+    if (options_.refresh_restart && level > 0 && (trail_offset_.empty() || trail_offset_.back().level == 0)) {
+        return true;
+    }
+    // Computing the size of the tableau is linear in the number of rows and
+    // computing the bit-size is linear in the number of non-zeros. Checking
+    // at most once every m pivots amortizes these costs.
+    if (options_.refresh_factor > 0 && statistics_.pivots >= refresh_checked_ + n_basic_) {
+        refresh_checked_ = statistics_.pivots;
+        return tableau_.size() > options_.refresh_factor * refresh_size_ ||
+               tableau_.bits() > options_.refresh_factor * refresh_bits_;
+    }
+    return false;
+}
+
+template <typename Value, typename Matrix> void Solver<Value, Matrix>::refresh_() {
+    // The initial tableau expresses the inequalities in terms of the problem
+    // variables. We pivot a copy of it until its basic variables coincide
+    // with the current ones. Only variables that are basic now are pivoted
+    // in and only rows whose basic variable is non-basic now are pivoted
+    // out. Such a row always exists because the current basis is regular.
+    //
+    // The positions of variables in the recomputed tableau are tracked in
+    // the two vectors below and replace the current ones afterward.
+    auto n = n_non_basic_;
+    auto before = tableau_.size();
+    auto tableau = initial_;
+    std::vector<index_t> index(variables_.size());
+    std::iota(index.begin(), index.end(), 0);
+    auto reverse = index;
+    for (index_t x = 0; x < n; ++x) {
+        if (variables_[x].reverse_index < n) {
+            continue;
+        }
+        auto j = reverse[x];
+        auto i = std::numeric_limits<index_t>::max();
+        tableau.update_col(j, [&](index_t k, Integer const &a_kj, Integer const &d_k) {
+            static_cast<void>(a_kj);
+            static_cast<void>(d_k);
+            if (i == std::numeric_limits<index_t>::max() && variables_[index[k + n]].reverse_index < n) {
+                i = k;
+            }
+        });
+        assert(i != std::numeric_limits<index_t>::max());
+        Integer *a_ij = nullptr;
+        Integer *d_i = nullptr;
+        tableau.unsafe_get(i, j, a_ij, d_i);
+        tableau.pivot(i, j, *a_ij, *d_i);
+        std::swap(reverse[index[i + n]], reverse[index[j]]);
+        std::swap(index[i + n], index[j]);
+    }
+
+    // Rows to propagate are marked by their position.
+    for (auto &i : propagate_queue_) {
+        variables_[i].propagate = false;
+        i = reverse[variables_[i + n].index] - n;
+    }
+    for (auto i : propagate_queue_) {
+        variables_[i].propagate = true;
+    }
+    for (index_t k = 0; k < variables_.size(); ++k) {
+        variables_[k].index = index[k];
+        variables_[k].reverse_index = reverse[k];
+    }
+    for (auto x : eliminated_) {
+        tableau.clear_col(reverse[x]);
+    }
+    // The pivots above record eta matrices in the revised engine, which
+    // would otherwise be carried over into the refreshed tableau.
+    if constexpr (std::is_same_v<Matrix, RevisedTableau>) {
+        tableau.refactor();
+    }
+    tableau_ = std::move(tableau);
+
+    refresh_size_ = tableau_.size();
+    refresh_bits_ = tableau_.bits();
+    refresh_pivots_ = statistics_.pivots;
+    refresh_checked_ = statistics_.pivots;
+    ++statistics_.refreshes;
+    statistics_.refresh_nonzeros_before += before;
+    statistics_.refresh_nonzeros_after += refresh_size_;
+    assert_extra(check_tableau_());
+    assert_extra(check_basic_());
+    assert_extra(check_non_basic_());
+}
+
+template <typename Value, typename Matrix> void Solver<Value, Matrix>::eliminate_() {
+    // Let x_j be a non-basic variable fixed to value v on level 0 and y_i a
+    // basic variable with y_i = a_ij x_j + r_i. Then the offset c = a_ij v
+    // is moved into the value and the bounds of y_i giving y_i - c = r_i.
+    // Afterward, the column of x_j is no longer needed. Because the bounds
+    // of x_j cannot change anymore, the variable is never selected for
+    // pivoting again. Variables that are basic at the moment are kept for
+    // later calls.
+    //
+    // The variables bounding the objective are excluded because their
+    // bounds are tightened in place.
+    auto jt = fixed_.begin();
+    for (auto x : fixed_) {
+        auto &x_j = variables_[x];
+        if (x_j.eliminated || (objective_ && (x == objective_.var || x == objective_.bound_var))) {
+            continue;
+        }
+        if (x_j.reverse_index >= n_non_basic_) {
+            *jt++ = x;
+            continue;
+        }
+        assert(!x_j.has_conflict());
+        tableau_.update_col(x_j.reverse_index, [&, this](index_t i, Integer const &a_ij, Integer const &d_i) {
+            auto &y_i = basic_(i);
+            auto c = x_j.value * a_ij / d_i;
+            y_i.value -= c;
+            if (y_i.dirty) {
+                y_i.saved -= c;
+            }
+            for (auto *bound : y_i.bounds) {
+                bound->value -= c;
+            }
+            if (objective_.bound != nullptr && variables_[i + n_non_basic_].index == objective_.bound_var) {
+                objective_.bound->value -= c;
+            }
+            y_i.offset += c;
+            ++statistics_.eliminated_nonzeros;
+        });
+        tableau_.clear_col(x_j.reverse_index);
+        x_j.eliminated = true;
+        eliminated_.emplace_back(x);
+        ++statistics_.eliminated_columns;
+    }
+    fixed_.erase(jt, fixed_.end());
+    assert_extra(check_tableau_());
+    assert_extra(check_basic_());
+}
+
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::dormant_(index_t x) const -> bool {
+    // A basic variable without bounds can never be conflicting. Hence, its
+    // value only matters once it receives a bound or when it is queried.
+    //
+    // Only the values saved when partially storing satisfying assignments
+    // can be recomputed once a dormant variable wakes up (see update_bound_).
+    auto const &x_i = variables_[x];
+    return options_.lazy_rows && options_.store_sat_assignment == StoreSATAssignments::Partial &&
+           x_i.reverse_index >= n_non_basic_ && !x_i.has_lower() && !x_i.has_upper();
+}
+
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::row_value_(index_t i) const -> Value {
+    Value v_i;
+    tableau_.update_row(i, [&](index_t j, Integer const &a_ij, Integer const &d_i) {
+        v_i += variables_[variables_[j].index].value * a_ij / d_i;
+    });
+    return v_i;
+}
+
+template <typename Value, typename Matrix> auto Solver<Value, Matrix>::saved_row_value_(index_t i) const -> Value {
+    Value v_i;
+    tableau_.update_row(i, [&](index_t j, Integer const &a_ij, Integer const &d_i) {
+        auto const &x_j = variables_[variables_[j].index];
+        v_i += (x_j.dirty ? x_j.saved : x_j.value) * a_ij / d_i;
+    });
+    return v_i;
+}
+
+template <typename Value, typename Matrix> void Solver<Value, Matrix>::defer_update_(index_t x) {
+    auto &x_j = variables_[x];
+    assert(x_j.reverse_index < n_non_basic_);
+    if (!x_j.pending && x_j.has_conflict()) {
+        x_j.pending = true;
+        pending_.emplace_back(x);
+    }
+}
+
+template <typename Value, typename Matrix> void Solver<Value, Matrix>::flush_updates_(index_t level) {
+    // Clasp often passes many literals at once. Instead of walking the column
+    // of a non-basic variable for each of its bounds, the variable is moved
+    // once to its tightest violated bound. Rows are enqueued after all
+    // columns have been updated so that each row is inspected only once.
+    for (auto x : pending_) {
+        auto &x_j = variables_[x];
+        x_j.pending = false;
+        Value const *v = nullptr;
+        if (x_j.has_lower() && x_j.value < x_j.lower()) {
+            v = &x_j.lower();
+        } else if (x_j.has_upper() && x_j.value > x_j.upper()) {
+            v = &x_j.upper();
+        } else {
+            continue;
+        }
+        auto d = *v - x_j.value;
+        tableau_.update_col(x_j.reverse_index, [&, this](index_t i, Integer const &a_ij, Integer const &d_i) {
+            if (!dormant_(variables_[i + n_non_basic_].index)) {
+                basic_(i).set_value(*this, level, d * a_ij / d_i, true);
+            }
+            // Note that this marks the row not the variable.
+            if (!variables_[i].touched) {
+                variables_[i].touched = true;
+                touched_.emplace_back(i);
+            }
+        });
+        x_j.set_value(*this, level, *v, false);
+    }
+    pending_.clear();
+    for (auto i : touched_) {
+        variables_[i].touched = false;
+        enqueue_(i);
+    }
+    touched_.clear();
+}
+
+template <typename Value, typename Matrix> void Solver<Value, Matrix>::update_(index_t level, index_t j, Value v) {
     auto &xj = non_basic_(j);
     tableau_.update_col(j, [&](index_t i, Integer const &a_ij, Integer d_i) {
-        basic_(i).set_value(*this, level, (v - xj.value) * a_ij / d_i, true);
+        if (!dormant_(variables_[i + n_non_basic_].index)) {
+            basic_(i).set_value(*this, level, (v - xj.value) * a_ij / d_i, true);
+        }
         enqueue_(i);
     });
     xj.set_value(*this, level, std::move(v), false);
 }
 
-template <typename Value> void Solver<Value>::pivot_(index_t level, index_t i, index_t j, Value const &v) {
+template <typename Value, typename Matrix>
+void Solver<Value, Matrix>::pivot_(index_t level, index_t i, index_t j, Value const &v) {
+    CLINGOLPX_TIMER_SCOPE(statistics_.time_pivot);
+    CLINGOLPX_TRACE_SCOPE(trace_, "pivot");
     Integer *a_ij = nullptr;
     Integer *d_i = nullptr;
     tableau_.unsafe_get(i, j, a_ij, d_i);
@@ -942,12 +1612,18 @@ template <typename Value> void Solver<Value>::pivot_(index_t level, index_t i, i
     xj.set_value(*this, level, v_j, true);
     tableau_.update_col(j, [&](index_t k, Integer const &a_kj, Integer const &d_k) {
         if (k != i) {
-            basic_(k).set_value(*this, level, v_j * a_kj / d_k, true);
+            if (!dormant_(variables_[k + n_non_basic_].index)) {
+                basic_(k).set_value(*this, level, v_j * a_kj / d_k, true);
+            }
             enqueue_(k);
         }
     });
     assert_extra(check_tableau_());
 
+    // x_i becomes non-basic and no longer needs to be considered
+    conflicts_.remove(variables_[i + n_non_basic_].index);
+    touch_(variables_[i + n_non_basic_].index);
+
     // swap variables x_i and x_j
     std::swap(xi.reverse_index, xj.reverse_index);
     std::swap(variables_[i + n_non_basic_].index, variables_[j].index);
@@ -962,21 +1638,24 @@ template <typename Value> void Solver<Value>::pivot_(index_t level, index_t i, i
     assert_extra(check_non_basic_());
 }
 
-template <typename Value>
-auto Solver<Value>::select_(index_t &ret_i, index_t &ret_j, Value const *&ret_v) -> typename Solver<Value>::State {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::select_(index_t &ret_i, index_t &ret_j, Value const *&ret_v, bool bland)
+    -> typename Solver<Value, Matrix>::State {
+    CLINGOLPX_TIMER_SCOPE(statistics_.time_select);
+    CLINGOLPX_TRACE_SCOPE(trace_, "select");
     // This implements Bland's rule selecting the variables with the smallest
-    // indices for pivoting.
+    // indices for pivoting. Optionally, the entering variable is chosen by
+    // the sparsity of its column instead. Pivoting updates one row per
+    // non-zero in the column, which determines both the cost of the pivot
+    // and the fill-in it may cause. Ties are broken by index.
 
     for (; !conflicts_.empty(); conflicts_.pop()) {
         auto ii = conflicts_.top();
         auto &xi = variables_[ii];
         auto i = xi.reverse_index;
         assert(ii == variables_[i].index);
-        xi.queued = false;
-        // the queue might contain variables that meanwhile became basic
-        if (i < n_non_basic_) {
-            continue;
-        }
+        // variables are removed from the queue when they become non-basic
+        assert(i >= n_non_basic_);
         i -= n_non_basic_;
 
         bool lower = xi.has_lower() && xi.value < xi.lower();
@@ -984,11 +1663,12 @@ auto Solver<Value>::select_(index_t &ret_i, index_t &ret_j, Value const *&ret_v)
             conflict_clause_.clear();
             conflict_clause_.emplace_back(lower ? -xi.lower_bound->lit : -xi.upper_bound->lit);
             index_t kk = variables_.size();
+            size_t cost = 0;
             tableau_.update_row(i, [&](index_t j, Integer const &a_ij, Integer const &d_i) {
                 auto jj = variables_[j].index;
                 // skip over the variable if we already have a better one
                 // according to blands rule
-                if (jj > kk) {
+                if (bland && jj > kk) {
                     return;
                 }
                 auto &x_j = variables_[jj];
@@ -999,6 +1679,13 @@ auto Solver<Value>::select_(index_t &ret_i, index_t &ret_j, Value const *&ret_v)
                 }
                 // we can set x_i to one of its bounds to get rid of the conflict
                 else {
+                    if (!bland) {
+                        auto c = tableau_.col_size(j);
+                        if (kk != variables_.size() && (c > cost || (c == cost && jj > kk))) {
+                            return;
+                        }
+                        cost = c;
+                    }
                     kk = jj;
                     ret_i = i;
                     ret_j = j;
@@ -1018,24 +1705,33 @@ auto Solver<Value>::select_(index_t &ret_i, index_t &ret_j, Value const *&ret_v)
     return State::Satisfiable;
 }
 
-template <typename Value>
-auto Solver<Value>::adjust(Clingo::Assignment const &assign, Clingo::literal_t lit) const -> Clingo::literal_t {
+template <typename Value, typename Matrix>
+auto Solver<Value, Matrix>::adjust(Clingo::Assignment const &assign, Clingo::literal_t lit) const -> Clingo::literal_t {
     static_cast<void>(assign);
     if (options_.select == SelectionHeuristic::None) {
         return lit;
     }
+    // The values of dormant variables are computed on demand.
+    Value buffer;
+    auto get_value = [&, this](index_t x) -> Value const & {
+        if (dormant_(x)) {
+            buffer = row_value_(variables_[x].reverse_index - n_non_basic_);
+            return buffer;
+        }
+        return variables_[x].value;
+    };
     // Note that the tests could be strengthend further, we could check if
     // setting the value to its bound would cause a conflict or match.
     for (auto it = bounds_.find(lit), ie = bounds_.end(); it != ie && it->first == lit; ++it) {
         Bound const &bound = it->second;
-        Value const &value = variables_[bound.variable].value;
+        Value const &value = get_value(bound.variable);
         if (bound.compare(value) == (options_.select == SelectionHeuristic::Conflict)) {
             return -lit;
         }
     }
     for (auto it = bounds_.find(-lit), ie = bounds_.end(); it != ie && it->first == -lit; ++it) {
         Bound const &bound = it->second;
-        Value const &value = variables_[bound.variable].value;
+        Value const &value = get_value(bound.variable);
         if (bound.compare(value) == (options_.select == SelectionHeuristic::Match)) {
             return -lit;
         }
@@ -1043,160 +1739,9 @@ auto Solver<Value>::adjust(Clingo::Assignment const &assign, Clingo::literal_t l
     return lit;
 }
 
-template <typename Value> void Propagator<Value>::init(Clingo::PropagateInit &init) {
-    facts_offset_ = facts_.size();
-    if (facts_offset_ > 0 || options_.global_objective.has_value()) {
-        init.set_check_mode(Clingo::PropagatorCheckMode::Both);
-    }
-
-    evaluate_theory(
-        init.theory_atoms(), [&](Clingo::literal_t lit) { return init.solver_literal(lit); }, aux_map_, iqs_,
-        objective_);
-
-    auto gather_vars = [this](std::vector<Term> const &terms) {
-        for (auto const &term : terms) {
-            if (var_map_.emplace(term.var, var_map_.size()).second) {
-                var_vec_.emplace_back(term.var);
-            }
-        }
-    };
-    gather_vars(objective_);
-    for (auto &x : iqs_) {
-        gather_vars(x.lhs);
-        init.add_watch(x.lit);
-    }
-
-    objective_state_.reset();
-
-    slvs_.clear();
-    slvs_.reserve(init.number_of_threads());
-    for (size_t i = 0, e = init.number_of_threads(); i != e; ++i) {
-        slvs_.emplace_back(std::piecewise_construct, std::forward_as_tuple(0), std::forward_as_tuple(options_));
-        if (!slvs_.back().second.prepare(init, var_map_, iqs_, objective_, i == 0)) {
-            return;
-        }
-    }
-}
-
-template <typename Value> void Propagator<Value>::register_control(Clingo::Control &ctl) {
-    ctl.register_propagator(*this);
-    if constexpr (std::is_same_v<Value, RationalQ>) {
-        ctl.add("base", {}, THEORY_Q);
-    } else {
-        ctl.add("base", {}, THEORY);
-    }
-}
-
-template <typename Value>
-void Propagator<Value>::on_statistics(Clingo::UserStatistics step, Clingo::UserStatistics accu) {
-    auto step_simplex = step.add_subkey("Simplex", Clingo::StatisticsType::Map);
-    auto step_pivots = step_simplex.add_subkey("Pivots", Clingo::StatisticsType::Value);
-    auto step_propagated_bounds = step_simplex.add_subkey("Bounds propagated", Clingo::StatisticsType::Value);
-    auto accu_simplex = accu.add_subkey("Simplex", Clingo::StatisticsType::Map);
-    auto accu_pivots = accu_simplex.add_subkey("Pivots", Clingo::StatisticsType::Value);
-    auto accu_propagated_bounds = accu_simplex.add_subkey("Bounds propagated", Clingo::StatisticsType::Value);
-    for (auto const &[offset, slv] : slvs_) {
-        step_pivots.set_value(slv.statistics().pivots);
-        accu_pivots.set_value(accu_pivots.value() + slv.statistics().pivots);
-        step_propagated_bounds.set_value(slv.statistics().propagated_bounds);
-        accu_propagated_bounds.set_value(accu_propagated_bounds.value() + slv.statistics().propagated_bounds);
-    }
-}
-
-template <typename Value>
-auto Propagator<Value>::decide(Clingo::id_t thread_id, Clingo::Assignment const &assign, Clingo::literal_t fallback)
-    -> Clingo::literal_t {
-    return slvs_[thread_id].second.adjust(assign, fallback);
-}
-
-template <typename Value> void Propagator<Value>::on_model(Clingo::Model const &model) {
-    if (!options_.global_objective.has_value()) {
-        return;
-    }
-    auto &slv = slvs_[model.thread_id()].second;
-    auto objective = slv.get_objective();
-    if (!objective.has_value()) {
-        return;
-    }
-    objective_state_.update(*std::move(objective));
-}
-
-template <typename Value> void Propagator<Value>::check(Clingo::PropagateControl &ctl) {
-    auto ass = ctl.assignment();
-    auto &[offset, slv] = slvs_[ctl.thread_id()];
-    if (ass.decision_level() == 0 && offset < facts_offset_) {
-        auto res = slv.solve(ctl, Clingo::LiteralSpan{facts_.data() + offset, facts_offset_}); // NOLINT
-        offset = facts_offset_;
-        // can happen in case of a top-level conflict
-        if (!res) {
-            return;
-        }
-    }
-    // Integrate the current objective value into the solver (if it is better).
-    if (!slv.integrate_objective(ctl, objective_state_)) {
-        return;
-    }
-    if (ass.is_total()) {
-        // Compute an optimal assignment.
-        slv.optimize();
-        // Store the current assignment in the hope that the next model can be
-        // obtained from it with a small number of pivots.
-        if (options_.store_sat_assignment >= StoreSATAssignments::Partial) {
-            slv.store_sat_assignment();
-        }
-        // Discard bounded assignments if the objective value is unbounded.
-        if (!slv.discard_bounded(ctl)) {
-            return;
-        }
-    }
-}
-
-template <typename Value>
-void Propagator<Value>::propagate(Clingo::PropagateControl &ctl, Clingo::LiteralSpan changes) {
-    auto ass = ctl.assignment();
-    if (ass.decision_level() == 0 && ctl.thread_id() == 0) {
-        // Note to self: auxiliary variables introduced during solving cannot become facts
-        facts_.insert(facts_.end(), changes.begin(), changes.end());
-    }
-    auto &[offset, slv] = slvs_[ctl.thread_id()];
-    static_cast<void>(slv.solve(ctl, changes));
-}
-
-template <typename Value>
-void Propagator<Value>::undo(Clingo::PropagateControl const &ctl, Clingo::LiteralSpan changes) noexcept {
-    static_cast<void>(changes);
-    slvs_[ctl.thread_id()].second.undo();
-}
-
-template <typename Value> auto Propagator<Value>::lookup_symbol(Clingo::Symbol symbol) const -> std::optional<index_t> {
-    if (auto it = var_map_.find(symbol); it != var_map_.end()) {
-        return it->second;
-    }
-    return {};
-}
-
-template <typename Value> auto Propagator<Value>::get_symbol(index_t i) const -> Clingo::Symbol { return var_vec_[i]; }
-
-template <typename Value> auto Propagator<Value>::has_value(index_t thread_id, index_t i) const -> bool {
-    static_cast<void>(thread_id);
-    return i < var_vec_.size();
-}
-
-template <typename Value> auto Propagator<Value>::get_value(index_t thread_id, index_t i) const -> Value {
-    return slvs_[thread_id].second.get_value(i);
-}
-
-template <typename Value>
-auto Propagator<Value>::get_objective(index_t thread_id) const -> std::optional<std::pair<Value, bool>> {
-    return slvs_[thread_id].second.get_objective();
-}
-
-template <typename Value> auto Propagator<Value>::n_values(index_t thread_id) const -> index_t {
-    static_cast<void>(thread_id);
-    return var_vec_.size();
-}
-
-template class Solver<Rational>;
-template class Solver<RationalQ>;
-template class Propagator<Rational>;
-template class Propagator<RationalQ>;
+template class ObjectiveState<Rational>;
+template class ObjectiveState<RationalQ>;
+template class Solver<Rational, Tableau>;
+template class Solver<RationalQ, Tableau>;
+template class Solver<Rational, RevisedTableau>;
+template class Solver<RationalQ, RevisedTableau>;
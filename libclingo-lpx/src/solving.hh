@@ -1,18 +1,25 @@
 #pragma once
 
+#include "heap.hh"
 #include "parsing.hh"
 #include "problem.hh"
+#include "record.hh"
+#include "revised.hh"
 #include "tableau.hh"
+#include "trace.hh"
 #include "util.hh"
 
 #include <clingo.hh>
 
+#include <atomic>
 #include <deque>
 #include <mutex>
 #include <optional>
-#include <queue>
 #include <shared_mutex>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 using SymbolMap = std::unordered_map<Clingo::Symbol, index_t>;
 using SymbolVec = std::vector<Clingo::Symbol>;
@@ -35,22 +42,94 @@ enum class PropagateMode : int {
     Full = 2,
 };
 
+enum class EnteringRule : int {
+    Bland = 0,
+    Markowitz = 1,
+};
+
+enum class Portfolio : int {
+    None = 0,
+    Mixed = 1,
+};
+
 struct Options {
     SelectionHeuristic select = SelectionHeuristic::None;
     StoreSATAssignments store_sat_assignment = StoreSATAssignments::No;
     std::optional<RationalQ> global_objective = std::nullopt;
     PropagateMode propagate_mode = PropagateMode::None;
     bool propagate_conflicts = false;
+    bool share_facts = false;
+    Portfolio portfolio = Portfolio::None;
+    EnteringRule entering = EnteringRule::Bland;
+    //! Do not maintain the values of basic variables without active bounds.
+    //!
+    //! This requires storing satisfying assignments partially. With a mixed
+    //! portfolio, threads storing them differently ignore this option.
+    bool lazy_rows = false;
+    //! Remove the columns of variables fixed on decision level 0.
+    bool eliminate_fixed = false;
+    //! Refresh the tableau if its size or the bit-size of its coefficients
+    //! grows by this factor (zero disables the check).
+    size_t refresh_factor = 0;
+    //! Refresh the tableau when the search restarts from decision level 0.
+    bool refresh_restart = false;
+    //! The number of threads used to evaluate theory atoms.
+    size_t parse_threads = 1;
+    //! The names and arities of variables whose values are added to models.
+    //!
+    //! The values of all variables are added if unset.
+    std::optional<std::vector<std::pair<std::string, uint32_t>>> show_values = std::nullopt;
+    //! Whether to add the values of shown variables to models.
+    //!
+    //! If disabled, the shown values are only accessible via the assignment.
+    bool extend_model = true;
+    //! The file to write trace events to (tracing is disabled if empty).
+    std::string trace{};
+    //! The file to record the calls to the solvers to (recording is
+    //! disabled if empty).
+    std::string record{};
 };
 
+//! Get the options for the given thread according to the configured portfolio.
+//!
+//! The first thread always uses the given options.
+[[nodiscard]] auto thread_options(Options const &options, size_t thread_id) -> Options;
+
 struct Statistics {
     void reset();
 
     size_t pivots{0};
     size_t propagated_bounds{0};
+    size_t components{0};
+    size_t refreshes{0};
+    size_t refresh_nonzeros_before{0};
+    size_t refresh_nonzeros_after{0};
+    size_t eliminated_columns{0};
+    size_t eliminated_nonzeros{0};
+    //! The number of conflicts and the number of literals in their clauses.
+    size_t conflicts{0};
+    size_t conflict_literals{0};
+    //! The maximum sizes of the queues of conflicting and changed rows.
+    size_t max_conflict_queue{0};
+    size_t max_propagate_queue{0};
+    //! The cumulative time in seconds spent in the phases of the solver.
+    //!
+    //! Note that the times of solve() and optimize() include the times spent
+    //! selecting pivots and pivoting, and solve() includes propagation. Only
+    //! the times of solve() and propagation are measured unless the library
+    //! is compiled with CLINGOLPX_TIMERS.
+    double time_solve{0};
+    double time_select{0};
+    double time_pivot{0};
+    double time_propagate{0};
+    double time_optimize{0};
+    double time_undo{0};
 };
 
 //! Helper to distribute current best objective to solver threads.
+//!
+//! The generation is additionally stored in an atomic variable. Readers
+//! only acquire the lock if the generation changed since their last read.
 template <typename Value> class ObjectiveState {
   public:
     void reset();
@@ -64,12 +143,49 @@ template <typename Value> class ObjectiveState {
     std::mutex mutex_;
 #endif
     Value value_;
-    size_t generation_ = 0;
+    std::atomic<size_t> generation_{0};
     bool bounded_{true};
 };
 
+//! Helper to share level-0 bound literals between solver threads.
+//!
+//! Each literal associated with a bound has a slot in a fixed size buffer.
+//! Publishing a literal claims the next slot using an atomic increment and
+//! readers consume literals up to the first slot that has not been written
+//! yet. Hence, neither publishing nor fetching literals requires a lock.
+class FactChannel {
+  public:
+    //! Reset the channel to accept the given literals.
+    //!
+    //! This function must not be called while solving.
+    void reset(std::vector<Clingo::literal_t> lits);
+    //! Publish a literal that became a fact.
+    //!
+    //! Literals not associated with a bound and literals that have already
+    //! been published are ignored.
+    void publish(Clingo::literal_t lit);
+    //! Call f for each literal published at or after the given offset.
+    //!
+    //! The offset is advanced past the consumed literals. The function stops
+    //! and returns false as soon as f returns false.
+    template <typename F> auto fetch(size_t &offset, F &&f) -> bool;
+
+  private:
+    //! The sorted literals that can be published.
+    std::vector<Clingo::literal_t> lits_;
+    //! Flags marking which of the literals have been published.
+    std::vector<std::atomic<bool>> published_;
+    //! The published literals (zero marks slots not yet written).
+    std::vector<std::atomic<Clingo::literal_t>> facts_;
+    //! The number of claimed slots.
+    std::atomic<size_t> size_{0};
+};
+
 //! A solver for finding an assignment satisfying a set of inequalities.
-template <typename Value> class Solver {
+//!
+//! The tableau is either stored explicitly (Tableau) or computed from a
+//! factorization of the basis (RevisedTableau).
+template <typename Value, typename Matrix = Tableau> class Solver {
   private:
     //! Helper class to prepare the inequalities for solving.
     struct Prepare;
@@ -84,7 +200,7 @@ template <typename Value> class Solver {
         GreaterEqual = 1,
         Equal = 2,
     };
-    template <typename V> friend auto bound_rel(Relation rel) -> typename Solver<V>::BoundRelation;
+    template <typename V, typename M> friend auto bound_rel(Relation rel) -> typename Solver<V, M>::BoundRelation;
     //! The bounds associated with a Variable.
     //!
     //! In practice, there should be a lot of variables with just one bound.
@@ -126,6 +242,11 @@ template <typename Value> class Solver {
         Bound const *upper_bound{nullptr};
         //! The value of the variable.
         Value value{0};
+        //! The value in the last satisfying assignment if the variable is dirty.
+        Value saved{0};
+        //! The constant subtracted from the value and the bounds of the
+        //! variable when eliminating fixed variables.
+        Value offset{0};
         //! Helper index for pivoting variables.
         index_t index{0};
         //! Helper index to obtain row/column index of a variable.
@@ -133,17 +254,37 @@ template <typename Value> class Solver {
         //! The level the variable was assigned on.
         index_t level{0};
         //! The bounds associated with this variable.
-        std::vector<Bound const *> bounds;
-        //! Whether this variales is in the queue of conflicting variables.
-        bool queued{false};
+        std::vector<Bound *> bounds;
         //! Whether this variales is in the queue of (non-basic) variables to porpagate.
         bool propagate{false};
+        //! Whether this (non-basic) variable awaits a batched value update.
+        bool pending{false};
+        //! Whether the row with this index has been touched by a batched update.
+        bool touched{false};
+        //! Whether the value changed since the last satisfying assignment.
+        bool dirty{false};
+        //! Whether the column of this (non-basic) variable has been eliminated.
+        bool eliminated{false};
     };
     struct TrailOffset {
         index_t level;
         index_t bound;
         index_t assignment;
     };
+    //! A connected component of the graph connecting rows and columns with
+    //! non-zero coefficients.
+    //!
+    //! Pivots exchange variables of the same component. Hence, the
+    //! component associated with a row or column position never changes.
+    //!
+    //! Components only gate full bound propagation. Pivot selection, the
+    //! conflict queue, and the trail are shared by all components.
+    struct Component {
+        //! The rows in the component.
+        std::vector<index_t> rows;
+        //! Whether rows in the component have to be propagated again.
+        bool changed{false};
+    };
     //! Captures what is know about of the satisfiability of a problem while
     //! solving.
     enum class State { Satisfiable = 0, Unsatisfiable = 1, Unknown = 2 };
@@ -154,6 +295,8 @@ template <typename Value> class Solver {
         index_t var{0};
         //! The bound for global optimization.
         index_t bound_var{0};
+        //! The bound on `bound_var`, which is tightened in place.
+        Bound *bound{nullptr};
         //! The generation at which the last objective has been integrated.
         size_t generation{0};
         //! Whether there is an objective function.
@@ -166,20 +309,34 @@ template <typename Value> class Solver {
 
   public:
     //! Construct a new solver object.
-    Solver(Options const &options);
+    //!
+    //! Trace events are recorded in the given buffer if it is not null.
+    Solver(Options const &options, TraceBuffer *trace = nullptr);
 
     //! Prepare inequalities for solving.
     [[nodiscard]] auto prepare(Clingo::PropagateInit &init, SymbolMap const &symbols,
                                std::vector<Inequality> const &inequalities, std::vector<Term> const &objective,
                                bool master) -> bool;
 
+    //! Check if the solver can be extended with inequalities of subsequent
+    //! solving steps.
+    [[nodiscard]] auto extensible() const -> bool;
+
+    //! Add the inequalities starting at the given offset to the (previously
+    //! prepared) problem.
+    //!
+    //! The current basis and assignment are kept as a starting point for the
+    //! next solving step.
+    [[nodiscard]] auto extend(Clingo::PropagateInit &init, SymbolMap const &symbols,
+                              std::vector<Inequality> const &inequalities, size_t offset, bool master) -> bool;
+
     //! Solve the (previously prepared) problem.
     [[nodiscard]] auto solve(Clingo::PropagateControl &ctl, Clingo::LiteralSpan lits) -> bool;
 
     //! Undo assignments on the current level.
     void undo();
 
-    //! Get the currently assigned value.
+    //! Get the currently assigned value of the i-th problem variable.
     [[nodiscard]] auto get_value(index_t i) const -> Value;
 
     //! Get the currently assigned objective value.
@@ -194,17 +351,32 @@ template <typename Value> class Solver {
     //! Discard bounded solutions (if necessary).
     auto discard_bounded(Clingo::PropagateControl &ctl) -> bool;
 
+    //! Publish bound literals implied on level 0 and integrate the ones
+    //! published by other solvers.
+    auto share_facts(Clingo::PropagateControl &ctl, FactChannel &channel) -> bool;
+
     //! Ensure that the current (SAT) assignment will not be backtracked.
     void store_sat_assignment();
 
     //! Return the solve statistics.
     [[nodiscard]] auto statistics() const -> Statistics const &;
+    //! Get the number of non-zero elements in the tableau.
+    [[nodiscard]] auto tableau_size() const -> size_t;
+    //! Get the maximum number of bits of the coefficients in the tableau.
+    [[nodiscard]] auto tableau_bits() const -> size_t;
 
     //! Adjust the sign of the given literal so that it does not conflict with
     //! the current tableau.
     [[nodiscard]] auto adjust(Clingo::Assignment const &assign, Clingo::literal_t lit) const -> Clingo::literal_t;
 
   private:
+    //! Add the inequalities starting at the given offset.
+    [[nodiscard]] auto add_inequalities_(Clingo::PropagateInit &init, Prepare &prep,
+                                         std::vector<Inequality> const &inequalities, size_t offset, bool master)
+        -> bool;
+    //! Get the currently assigned value of variable `x`.
+    [[nodiscard]] auto value_(index_t x) const -> Value;
+
     //! Check if the tableau.
     [[nodiscard]] auto check_tableau_() -> bool;
     //! Check if basic variables with unsatisfied bounds are enqueued.
@@ -213,6 +385,10 @@ template <typename Value> class Solver {
     [[nodiscard]] auto check_non_basic_() -> bool;
     //! Check if the current assignment is a solution.
     [[nodiscard]] auto check_solution_() -> bool;
+    //! Remember the stored satisfying assignment for check_restore_().
+    [[nodiscard]] auto check_store_() -> bool;
+    //! Check if backtracking restored the last stored satisfying assignment.
+    [[nodiscard]] auto check_restore_() const -> bool;
     //! Print a readable representation of the internal problem to stderr.
     void debug_();
     //! Propagate (some) bounds.
@@ -221,8 +397,46 @@ template <typename Value> class Solver {
     //! Apply the given bound.
     [[nodiscard]] auto update_bound_(Clingo::PropagateControl &ctl, Bound const &bound) -> bool;
 
-    //! Insert a new bound dynamically.
+    //! Insert or tighten the bound on the objective.
     [[nodiscard]] auto assert_bound_(Clingo::PropagateControl &ctl, Value value) -> bool;
+    //! Check if the assignment violates the bound on the objective.
+    [[nodiscard]] auto objective_violated_() const -> bool;
+    //! Repair the assignment of the variable bounding the objective.
+    void repair_objective_();
+
+    //! Check if `x` is a dormant basic variable.
+    //!
+    //! The values of dormant variables are not maintained while pivoting or
+    //! updating non-basic variables. They are recomputed from their rows
+    //! once they receive a bound or when they are queried.
+    [[nodiscard]] auto dormant_(index_t x) const -> bool;
+    //! Compute the value of the basic variable associated with row `i`.
+    [[nodiscard]] auto row_value_(index_t i) const -> Value;
+    //! Compute the value of the basic variable associated with row `i` in
+    //! the last satisfying assignment.
+    [[nodiscard]] auto saved_row_value_(index_t i) const -> Value;
+
+    //! Schedule non-basic variable `x` for a batched value update if it
+    //! violates its bounds.
+    void defer_update_(index_t x);
+    //! Apply the pending value updates of non-basic variables.
+    void flush_updates_(index_t level);
+
+    //! Compute the connected components of the tableau.
+    void init_components_();
+    //! Mark the component of the given variable as changed.
+    void touch_(index_t x);
+
+    //! Check if the tableau should be refreshed before solving on the given
+    //! level.
+    [[nodiscard]] auto refresh_due_(index_t level) -> bool;
+    //! Recompute the tableau for the current basis from the original
+    //! inequalities.
+    void refresh_();
+
+    //! Substitute non-basic variables fixed on level 0 by their values and
+    //! remove their columns from the tableau.
+    void eliminate_();
 
     //! Enqueue basic variable `x_i` if it is conflicting.
     void enqueue_(index_t i);
@@ -234,7 +448,11 @@ template <typename Value> class Solver {
     void pivot_(index_t level, index_t i, index_t j, Value const &v);
 
     //! Select pivot point using Bland's rule.
-    auto select_(index_t &ret_i, index_t &ret_j, Value const *&ret_v) -> State;
+    //!
+    //! Unless `bland` is set, the entering variable is chosen among the
+    //! eligible ones by the fewest non-zeros in its column, which
+    //! approximates the Markowitz count because the leaving row is fixed.
+    auto select_(index_t &ret_i, index_t &ret_j, Value const *&ret_v, bool bland) -> State;
 
     //! Get basic variable associated with row `i`.
     auto basic_(index_t i) -> Variable &;
@@ -243,26 +461,71 @@ template <typename Value> class Solver {
 
     //! Options configuring the algorithms.
     Options const &options_;
+    //! The buffer recording trace events.
+    TraceBuffer *trace_;
     //! Mapping from literals to bounds.
     std::unordered_multimap<Clingo::literal_t, Bound> bounds_;
     //! Trail of bound assignments (variable, relation, Value).
     std::vector<std::tuple<index_t, BoundRelation, Bound const *>> bound_trail_;
     //! Trail for assignments (level, variable, Value).
     std::vector<std::tuple<index_t, index_t, Value>> assignment_trail_;
+    //! Variables changed since the last satisfying assignment.
+    //!
+    //! This replaces the assignment trail when partially storing satisfying
+    //! assignments.
+    std::vector<index_t> dirty_;
+    //! The values in the last satisfying assignment (only recorded by
+    //! check_store_() when partially storing satisfying assignments).
+    std::vector<Value> sat_values_;
     //! Trail offsets per level.
     std::vector<TrailOffset> trail_offset_;
     //! The tableau of coefficients.
-    Tableau tableau_;
+    Matrix tableau_;
+    //! The tableau before the first pivot (only stored if refreshing is
+    //! enabled).
+    Matrix initial_;
     //! The non-basic and basic variables.
     std::vector<Variable> variables_;
-    //! The set of conflicting variables.
-    std::priority_queue<index_t, std::vector<index_t>, std::greater<>> conflicts_;
+    //! The variables associated with the problem variables.
+    std::vector<index_t> var_index_;
+    //! The set of conflicting basic variables ordered by their indices.
+    IndexedHeap<> conflicts_;
     //! The conflict clause.
     std::vector<Clingo::literal_t> conflict_clause_;
     //! The vector of non-basic variables to propagate.
     std::deque<index_t> propagate_queue_;
+    //! The non-basic variables with pending value updates.
+    std::vector<index_t> pending_;
+    //! The rows touched while flushing pending updates.
+    std::vector<index_t> touched_;
+    //! The component of each row and column position.
+    //!
+    //! Columns not connected to any row are not associated with a component.
+    std::vector<index_t> component_;
+    //! The connected components of the tableau.
+    std::vector<Component> components_;
+    //! The components whose rows have to be propagated again.
+    std::vector<index_t> changed_components_;
+    //! Variables whose bounds have been fixed on level 0 but whose columns
+    //! have not been eliminated yet.
+    std::vector<index_t> fixed_;
+    //! Variables whose columns have been eliminated.
+    std::vector<index_t> eliminated_;
+    //! Bound literals implied on level 0 that have not been published yet.
+    std::vector<Clingo::literal_t> facts_;
+    //! The number of literals already fetched from the fact channel.
+    size_t facts_offset_{0};
     //! Problem and solving statistics.
     Statistics statistics_;
+    //! The size of the tableau after the last refresh.
+    size_t refresh_size_{0};
+    //! The bit-size of the coefficients after the last refresh.
+    size_t refresh_bits_{0};
+    //! The number of pivots at the last refresh.
+    size_t refresh_pivots_{0};
+    //! The number of pivots at which the growth of the tableau has been
+    //! checked last.
+    size_t refresh_checked_{0};
     //! The number of non-basic variables.
     index_t n_non_basic_{0};
     //! The number of basic variables.
@@ -271,9 +534,16 @@ template <typename Value> class Solver {
     Objective objective_;
 };
 
-template <typename Value> class Propagator : public Clingo::Heuristic {
+template <typename Value, typename Matrix = Tableau> class Propagator : public Clingo::Heuristic {
   public:
-    Propagator(Options options) : options_{std::move(options)} {}
+    Propagator(Options options) : options_{std::move(options)} {
+        if (!options_.trace.empty()) {
+            trace_.open(options_.trace);
+        }
+        if (!options_.record.empty()) {
+            record_.open(options_.record, std::is_same_v<Value, RationalQ>);
+        }
+    }
     Propagator(Propagator const &) = default;
     Propagator(Propagator &&) noexcept = default;
     auto operator=(Propagator const &) -> Propagator & = default;
@@ -282,6 +552,15 @@ template <typename Value> class Propagator : public Clingo::Heuristic {
     void register_control(Clingo::Control &ctl);
     void on_statistics(Clingo::UserStatistics step, Clingo::UserStatistics accu);
     void on_model(Clingo::Model const &model);
+    //! Add an inequality guarded by a program literal.
+    //!
+    //! The inequality is added to the problem in the next call to init().
+    void add_inequality(Inequality iq);
+    //! Write the remaining trace events and close the trace and the
+    //! recording.
+    //!
+    //! Nothing is written if tracing and recording are disabled.
+    void finish();
 
     [[nodiscard]] auto lookup_symbol(Clingo::Symbol symbol) const -> std::optional<index_t>;
     [[nodiscard]] auto get_symbol(index_t i) const -> Clingo::Symbol;
@@ -304,9 +583,15 @@ template <typename Value> class Propagator : public Clingo::Heuristic {
     SymbolVec var_vec_;
     std::vector<Term> objective_;
     std::vector<Inequality> iqs_;
+    std::vector<Inequality> pending_iqs_;
     size_t facts_offset_{0};
     std::vector<Clingo::literal_t> facts_;
-    std::vector<std::pair<size_t, Solver<Value>>> slvs_;
+    std::vector<std::pair<size_t, Solver<Value, Matrix>>> slvs_;
     ObjectiveState<Value> objective_state_;
+    FactChannel fact_channel_;
     Options options_;
+    std::vector<Options> thread_options_;
+    bool share_facts_{false};
+    Trace trace_;
+    RecordWriter record_;
 };
@@ -182,6 +182,22 @@ void Tableau::pivot(index_t i, index_t j, Integer &a_ij, Integer &d_i) {
     }
 }
 
+void Tableau::clear_col(index_t j) {
+    if (j < cols_.size()) {
+        // Note that the column might refer to rows whose element has already
+        // been eliminated.
+        for (auto i : cols_[j]) {
+            auto &cells = rows_[i].cells;
+            auto it = std::lower_bound(cells.begin(), cells.end(), j);
+            if (it != cells.end() && it->col == j) {
+                cells.erase(it);
+                simplify_(i);
+            }
+        }
+        cols_[j].clear();
+    }
+}
+
 void Tableau::debug(char const *indent) const {
     size_t m = rows_.size();
     size_t n = cols_.size();
@@ -203,6 +219,17 @@ auto Tableau::size() const -> size_t {
                            [](size_t n, auto const &r) { return n + r.cells.size(); });
 }
 
+auto Tableau::bits() const -> size_t {
+    size_t n = 0;
+    for (auto const &row : rows_) {
+        n = std::max(n, row.den.bits());
+        for (auto const &cell : row.cells) {
+            n = std::max(n, cell.val.bits());
+        }
+    }
+    return n;
+}
+
 auto Tableau::empty() const -> bool {
     return std::all_of(rows_.cbegin(), rows_.cend(), [](auto const &r) { return r.cells.empty(); });
 }
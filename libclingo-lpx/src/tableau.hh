@@ -6,9 +6,7 @@
 #include <vector>
 
 #include "number.hh"
-
-//! Type used for array indices.
-using index_t = uint32_t;
+#include "util.hh"
 
 //! A sparse tableau with efficient access to both rows and columns.
 //!
@@ -63,6 +61,20 @@ class Tableau {
         }
     }
 
+    //! Call f(j, a_ij) for each element a_ij != 0 in row A_i.
+    //!
+    //! This overload does not permit changing elements.
+    //!
+    //! Runs in O(n).
+    template <typename F> void update_row(index_t i, F &&f) const {
+        if (i < rows_.size()) {
+            auto const &row = rows_[i];
+            for (auto const &[col, val] : row.cells) {
+                f(static_cast<index_t>(col), val, row.den);
+            }
+        }
+    }
+
     //! Call f(i, a_ij) for each element a_ij != 0 in column A^T_j.
     //!
     //! The same remark as for update_row() applies.
@@ -98,11 +110,30 @@ class Tableau {
     //! Runs in O(m*m).
     void pivot(index_t i, index_t j, Integer &a_ij, Integer &d_i);
 
+    //! Set all elements in column A^T_j to zero.
+    //!
+    //! Runs in O(m*n).
+    void clear_col(index_t j);
+
+    //! Get an upper bound on the number of non-zero elements in column A^T_j.
+    //!
+    //! The bound is exact unless elements in the column have been eliminated
+    //! since the last call to update_col().
+    //!
+    //! Runs in O(1).
+    [[nodiscard]] auto col_size(index_t j) const -> size_t { return j < cols_.size() ? cols_[j].size() : 0; }
+
     //! Get the number of non-zero elements in the tableau.
     //!
     //! Runs in O(m).
     [[nodiscard]] auto size() const -> size_t;
 
+    //! Get the maximum number of bits of the numerators and denominators in
+    //! the tableau.
+    //!
+    //! Runs in O(m*n).
+    [[nodiscard]] auto bits() const -> size_t;
+
     //! Equivalent to `size() == 0`.
     //!
     //! Runs in O(m).
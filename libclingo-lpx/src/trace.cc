@@ -0,0 +1,95 @@
+#include "trace.hh"
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+void Trace::enable(std::ostream &out) {
+    out_ = &out;
+    *out_ << "[";
+}
+
+void Trace::open(std::string const &filename) {
+    file_.open(filename);
+    if (!file_) {
+        throw std::runtime_error("could not open trace file: " + filename);
+    }
+    enable(file_);
+}
+
+void Trace::reserve(size_t n_threads) {
+    while (buffers_.size() < n_threads) {
+        buffers_.emplace_back(origin_);
+    }
+}
+
+auto Trace::buffer(size_t thread_id) -> TraceBuffer * {
+    if (!enabled()) {
+        return nullptr;
+    }
+    reserve(thread_id + 1);
+    return &buffers_[thread_id];
+}
+
+void Trace::separate_() {
+    *out_ << (sep_ ? ",\n" : "\n");
+    sep_ = true;
+}
+
+void Trace::flush() {
+    if (!enabled()) {
+        return;
+    }
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+    auto &out = *out_;
+    // timestamps are given in microseconds
+    auto write_time = [&out](int64_t time) {
+        out << time / 1000 << "." << std::setw(3) << std::setfill('0') << time % 1000 << std::setfill(' ');
+    };
+    size_t tid = 0;
+    for (auto &buffer : buffers_) {
+        if (tid >= n_named_) {
+            separate_();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+                << ",\"args\":{\"name\":\"solver " << tid << "\"}}";
+            n_named_ = tid + 1;
+        }
+        for (auto const &event : buffer.events_) {
+            separate_();
+            out << "{\"name\":\"" << event.name << "\",\"ph\":\"" << (event.begin ? 'B' : 'E') << "\",\"ts\":";
+            write_time(event.time);
+            out << ",\"pid\":1,\"tid\":" << tid << "}";
+        }
+        if (buffer.n_dropped_ > 0) {
+            separate_();
+            out << "{\"name\":\"dropped events\",\"ph\":\"i\",\"s\":\"t\",\"ts\":";
+            write_time(buffer.now_());
+            out << ",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"count\":" << buffer.n_dropped_ << "}}";
+        }
+        buffer.events_.clear();
+        buffer.n_dropped_ = 0;
+        ++tid;
+    }
+    out.flush();
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+    if (!out) {
+        throw std::runtime_error("could not write trace file");
+    }
+}
+
+void Trace::close() {
+    if (!enabled()) {
+        return;
+    }
+    flush();
+    *out_ << "\n]\n";
+    out_->flush();
+    auto good = static_cast<bool>(*out_);
+    out_ = nullptr;
+    if (file_.is_open()) {
+        file_.close();
+    }
+    if (!good) {
+        throw std::runtime_error("could not write trace file");
+    }
+}
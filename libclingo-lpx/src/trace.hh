@@ -0,0 +1,159 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifdef CLINGOLPX_TRACE
+//! Record the lifetime of the enclosing scope in the given trace buffer.
+//!
+//! The buffer might be a null pointer in which case nothing is recorded. The
+//! macro expands to nothing unless tracing support is compiled in.
+#define CLINGOLPX_TRACE_SCOPE(BUFFER, NAME) TraceScope trace_scope_{BUFFER, NAME} // NOLINT
+#else
+#define CLINGOLPX_TRACE_SCOPE(BUFFER, NAME) static_cast<void>(BUFFER) // NOLINT
+#endif
+
+//! Buffer of begin and end events recorded by a single thread.
+//!
+//! The buffer holds at most max_events events between two flushes of the
+//! trace. Further events are dropped and counted. Events are dropped in
+//! matching pairs: while the buffer is full, begin events are dropped along
+//! with their end events.
+class TraceBuffer {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    //! The maximum number of events recorded between two flushes.
+    static constexpr size_t max_events = size_t{1} << 20U;
+
+    TraceBuffer(Clock::time_point origin) : origin_{origin} {}
+
+    //! Record the beginning of the given event.
+    //!
+    //! The name must be a string literal.
+    void begin(char const *name) {
+        if (n_skipped_ > 0 || events_.size() >= max_events) {
+            ++n_skipped_;
+            ++n_dropped_;
+            return;
+        }
+        events_.push_back({name, now_(), true});
+    }
+    //! Record the end of the given event.
+    void end(char const *name) {
+        if (n_skipped_ > 0) {
+            --n_skipped_;
+            ++n_dropped_;
+            return;
+        }
+        events_.push_back({name, now_(), false});
+    }
+
+  private:
+    friend class Trace;
+
+    //! A begin or end event.
+    struct Event {
+        char const *name;
+        //! The time in nanoseconds since the creation of the trace.
+        int64_t time;
+        bool begin;
+    };
+
+    //! Get the nanoseconds elapsed since the creation of the trace.
+    [[nodiscard]] auto now_() const -> int64_t {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin_).count();
+    }
+
+    Clock::time_point origin_;
+    std::vector<Event> events_;
+    //! The number of open events whose begin event has been dropped.
+    size_t n_skipped_{0};
+    //! The number of events dropped since the last flush.
+    size_t n_dropped_{0};
+};
+
+//! Collects the trace buffers of all threads.
+//!
+//! The events are written in the JSON array variant of Chrome's trace-event
+//! format, which can be inspected with tools like chrome://tracing or
+//! Perfetto. Events are written and discarded whenever the trace is flushed.
+//! Because viewers accept arrays without the closing bracket, the output
+//! remains usable even if the trace is never closed.
+class Trace {
+  public:
+    Trace() = default;
+    Trace(Trace const &) = delete;
+    Trace(Trace &&) = delete;
+    auto operator=(Trace const &) -> Trace & = delete;
+    auto operator=(Trace &&) -> Trace & = delete;
+    ~Trace() = default;
+
+    //! Check whether events are recorded.
+    [[nodiscard]] auto enabled() const -> bool { return out_ != nullptr; }
+    //! Start recording events written to the given stream.
+    //!
+    //! The stream must outlive the trace or its closing.
+    void enable(std::ostream &out);
+    //! Start recording events written to the given file.
+    void open(std::string const &filename);
+
+    //! Make sure that there are buffers for the given number of threads.
+    //!
+    //! Buffers are never removed and pointers to them stay valid.
+    void reserve(size_t n_threads);
+    //! Get the buffer of the given thread.
+    //!
+    //! Returns a null pointer if the trace is not enabled.
+    [[nodiscard]] auto buffer(size_t thread_id) -> TraceBuffer *;
+
+    //! Write and discard the events recorded so far.
+    //!
+    //! This function must not be called while threads record events.
+    void flush();
+    //! Flush the trace and terminate the JSON array.
+    //!
+    //! No further events are written afterward.
+    void close();
+
+  private:
+    //! Write the separator preceding the next entry.
+    void separate_();
+
+    TraceBuffer::Clock::time_point origin_{TraceBuffer::Clock::now()};
+    std::deque<TraceBuffer> buffers_;
+    std::ofstream file_;
+    std::ostream *out_{nullptr};
+    //! The number of buffers whose thread names have been written.
+    size_t n_named_{0};
+    //! Whether an entry has been written.
+    bool sep_{false};
+};
+
+//! Record an event for the lifetime of the object.
+class TraceScope {
+  public:
+    TraceScope(TraceBuffer *buffer, char const *name) : buffer_{buffer}, name_{name} {
+        if (buffer_ != nullptr) {
+            buffer_->begin(name_);
+        }
+    }
+    TraceScope(TraceScope const &) = delete;
+    TraceScope(TraceScope &&) = delete;
+    auto operator=(TraceScope const &) -> TraceScope & = delete;
+    auto operator=(TraceScope &&) -> TraceScope & = delete;
+    ~TraceScope() {
+        if (buffer_ != nullptr) {
+            buffer_->end(name_);
+        }
+    }
+
+  private:
+    TraceBuffer *buffer_;
+    char const *name_;
+};
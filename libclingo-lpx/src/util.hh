@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <limits>
 #include <stdexcept>
 
@@ -10,6 +12,19 @@
 #define assert_extra(X) // NOLINT
 #endif
 
+#ifdef CLINGOLPX_TIMERS
+//! Add the time spent in the enclosing scope to the given variable.
+//!
+//! The macro is used for frequently called operations and expands to
+//! nothing unless fine-grained timers are compiled in.
+#define CLINGOLPX_TIMER_SCOPE(ELAPSED) Timer timer_scope_{ELAPSED} // NOLINT
+#else
+#define CLINGOLPX_TIMER_SCOPE(ELAPSED) static_cast<void>(ELAPSED) // NOLINT
+#endif
+
+//! Type used for array indices.
+using index_t = uint32_t;
+
 namespace detail {
 
 template <int X> using int_type = std::integral_constant<int, X>;
@@ -41,3 +56,19 @@ template <class T, class S> inline auto safe_cast(S s) -> T {
     detail::sc_check<T>(s, detail::int_type<sv>());
     return static_cast<T>(s);
 }
+
+//! Add the time elapsed during the lifetime of the timer to a variable.
+class Timer {
+  public:
+    //! Start the timer adding the elapsed seconds to the given variable.
+    explicit Timer(double &elapsed) noexcept : elapsed_{elapsed}, start_{std::chrono::steady_clock::now()} {}
+    Timer(Timer const &) = delete;
+    Timer(Timer &&) = delete;
+    auto operator=(Timer const &) -> Timer & = delete;
+    auto operator=(Timer &&) -> Timer & = delete;
+    ~Timer() { elapsed_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count(); }
+
+  private:
+    double &elapsed_;
+    std::chrono::steady_clock::time_point start_;
+};
@@ -0,0 +1,170 @@
+#include "clingo-lpx.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <clingo.hh>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using TheoryPtr = std::unique_ptr<clingolpx_theory_t, decltype(&clingolpx_destroy)>;
+
+auto create() -> TheoryPtr {
+    clingolpx_theory_t *theory = nullptr;
+    REQUIRE(clingolpx_create(&theory));
+    return {theory, &clingolpx_destroy};
+}
+
+//! Ground the given part, solve, and return the sorted names of the variables
+//! shown in the last model.
+auto shown(clingolpx_theory_t *theory, Clingo::Control &ctl, char const *part) -> std::vector<std::string> {
+    std::vector<std::string> names;
+    ctl.ground({{part, {}}});
+    auto handle = ctl.solve();
+    for (auto &model : handle) {
+        REQUIRE(clingolpx_on_model(theory, model.to_c()));
+        size_t const *indices = nullptr;
+        size_t size = 0;
+        REQUIRE(clingolpx_assignment_get_shown(theory, model.thread_id(), &indices, &size));
+        REQUIRE(std::is_sorted(indices, indices + size)); // NOLINT
+        names.clear();
+        for (size_t i = 0; i != size; ++i) {
+            names.emplace_back(Clingo::Symbol{clingolpx_get_symbol(theory, indices[i])}.to_string()); // NOLINT
+        }
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+//! Solve a program in two steps with the given show-values configuration
+//! and return the shown variables of both steps.
+auto shown(char const *show_values) -> std::pair<std::vector<std::string>, std::vector<std::string>> {
+    auto theory = create();
+    REQUIRE(clingolpx_configure(theory.get(), "show-values", show_values));
+    Clingo::Control ctl;
+    REQUIRE(clingolpx_register(theory.get(), ctl.to_c()));
+    ctl.add("base", {}, "&sum { x; y(1) } >= 1. &sum { x; 2*y(1) } <= 3.");
+    ctl.add("step", {}, "&sum { y(2) } >= 1. &sum { x; w } <= 5.");
+    auto first = shown(theory.get(), ctl, "base");
+    auto second = shown(theory.get(), ctl, "step");
+    return {first, second};
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+TEST_CASE("clingo-lpx") {
+    SECTION("refresh") {
+        auto theory = create();
+        REQUIRE(clingolpx_configure(theory.get(), "refresh", "2"));
+        REQUIRE(clingolpx_configure(theory.get(), "refresh", "0,restart"));
+        REQUIRE(!clingolpx_configure(theory.get(), "refresh", ",restart"));
+        REQUIRE(!clingolpx_configure(theory.get(), "refresh", "2,never"));
+        REQUIRE(!clingolpx_configure(theory.get(), "refresh", "18446744073709551616"));
+    }
+    SECTION("parse-threads") {
+        auto theory = create();
+        REQUIRE(clingolpx_configure(theory.get(), "parse-threads", "4"));
+        REQUIRE(!clingolpx_configure(theory.get(), "parse-threads", "0"));
+        REQUIRE(!clingolpx_configure(theory.get(), "parse-threads", ""));
+        REQUIRE(!clingolpx_configure(theory.get(), "parse-threads", "4x"));
+        REQUIRE(!clingolpx_configure(theory.get(), "parse-threads", "18446744073709551616"));
+        REQUIRE(!clingolpx_configure(theory.get(), "parse-threads", "99999999999999999999999"));
+    }
+    SECTION("lazy-rows") {
+        auto theory = create();
+        REQUIRE(clingolpx_configure(theory.get(), "lazy-rows", "no"));
+        REQUIRE(clingolpx_validate_options(theory.get()));
+        REQUIRE(clingolpx_configure(theory.get(), "lazy-rows", "yes"));
+        REQUIRE(!clingolpx_validate_options(theory.get()));
+        REQUIRE(clingolpx_configure(theory.get(), "store", "partial"));
+        REQUIRE(clingolpx_validate_options(theory.get()));
+    }
+    SECTION("show-values") {
+        using V = std::vector<std::string>;
+        auto theory = create();
+        REQUIRE(clingolpx_configure(theory.get(), "show-values", "y/1"));
+        REQUIRE(clingolpx_configure(theory.get(), "show-values", "y/1,w/0"));
+        REQUIRE(clingolpx_configure(theory.get(), "show-values", "y/4294967295"));
+        REQUIRE(!clingolpx_configure(theory.get(), "show-values", ""));
+        REQUIRE(!clingolpx_configure(theory.get(), "show-values", "y"));
+        REQUIRE(!clingolpx_configure(theory.get(), "show-values", "y/"));
+        REQUIRE(!clingolpx_configure(theory.get(), "show-values", "/1"));
+        REQUIRE(!clingolpx_configure(theory.get(), "show-values", "y/1x"));
+        REQUIRE(!clingolpx_configure(theory.get(), "show-values", "y/1,"));
+        REQUIRE(!clingolpx_configure(theory.get(), "show-values", "y/4294967296"));
+        REQUIRE(!clingolpx_configure(theory.get(), "show-values", "y/99999999999999999999"));
+
+        REQUIRE(shown("all") == std::pair{V{"x", "y(1)"}, V{"w", "x", "y(1)", "y(2)"}});
+        REQUIRE(shown("none") == std::pair{V{}, V{}});
+        REQUIRE(shown("y/1") == std::pair{V{"y(1)"}, V{"y(1)", "y(2)"}});
+        REQUIRE(shown("y/1,w/0") == std::pair{V{"y(1)"}, V{"w", "y(1)", "y(2)"}});
+        REQUIRE(shown("y/0,x/1") == std::pair{V{}, V{}});
+    }
+    SECTION("arrays") {
+        // x = 2^62 * y and y = 2^62 force a value of x not fitting into 64 bit integers
+        constexpr int64_t pow62 = int64_t{1} << 62;
+        auto theory = create();
+        Clingo::Control ctl;
+        REQUIRE(clingolpx_register(theory.get(), ctl.to_c()));
+        ctl.add("base", {}, "a.");
+        ctl.ground({{"base", {}}});
+        auto lit = ctl.symbolic_atoms().find(Clingo::Function("a", {}))->literal();
+        auto x = Clingo::Function("x", {});
+        auto y = Clingo::Function("y", {});
+        std::vector<clingo_symbol_t> vars{x.to_c(), y.to_c()};
+        std::vector<int64_t> cos{1, -pow62};
+        REQUIRE(clingolpx_add_constraint(theory.get(), lit, vars.data(), cos.data(), nullptr, vars.size(),
+                                         clingolpx_relation_equal, 0, 1));
+        REQUIRE(clingolpx_add_constraint(theory.get(), lit, &vars[1], cos.data(), nullptr, 1,
+                                         clingolpx_relation_equal, pow62, 1));
+        size_t n = 0;
+        auto handle = ctl.solve();
+        for (auto &model : handle) {
+            ++n;
+            auto thread_id = model.thread_id();
+            auto size = clingolpx_assignment_size(theory.get(), thread_id);
+            size_t index = 0;
+            REQUIRE(clingolpx_lookup_symbol(theory.get(), x.to_c(), &index));
+            REQUIRE(0 < index);
+            REQUIRE(index <= size);
+            std::vector<double> doubles(size + 1);
+            std::vector<int64_t> nums(size + 1);
+            REQUIRE(clingolpx_assignment_get_arrays(theory.get(), thread_id, size, nullptr, nullptr, doubles.data()));
+            REQUIRE(doubles[index - 1] == std::ldexp(1.0, 124));
+            REQUIRE(!clingolpx_assignment_get_arrays(theory.get(), thread_id, size, nums.data(), nullptr, nullptr));
+            REQUIRE(!clingolpx_assignment_get_arrays(theory.get(), thread_id, size + 1, nullptr, nullptr,
+                                                     doubles.data()));
+        }
+        REQUIRE(n == 1);
+    }
+    SECTION("extend-model") {
+        for (auto const *extend : {"yes", "no"}) {
+            auto theory = create();
+            REQUIRE(clingolpx_configure(theory.get(), "extend-model", extend));
+            Clingo::Control ctl;
+            REQUIRE(clingolpx_register(theory.get(), ctl.to_c()));
+            ctl.add("base", {}, "&sum { x; y(1) } >= 1. &sum { x; 2*y(1) } <= 3.");
+            ctl.ground({{"base", {}}});
+            auto handle = ctl.solve();
+            for (auto &model : handle) {
+                REQUIRE(clingolpx_on_model(theory.get(), model.to_c()));
+                auto symbols = model.symbols(Clingo::ShowType::Theory);
+                auto n_lpx = std::count_if(symbols.begin(), symbols.end(),
+                                           [](Clingo::Symbol sym) { return sym.match("__lpx", 2); });
+                REQUIRE(n_lpx == (std::strcmp(extend, "yes") == 0 ? 2 : 0));
+                size_t const *indices = nullptr;
+                size_t size = 0;
+                REQUIRE(clingolpx_assignment_get_shown(theory.get(), model.thread_id(), &indices, &size));
+                REQUIRE(size == 2);
+            }
+        }
+        REQUIRE(!clingolpx_configure(create().get(), "extend-model", "maybe"));
+    }
+}
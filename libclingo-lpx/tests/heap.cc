@@ -0,0 +1,67 @@
+#include "heap.hh"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+template <typename H> auto drain(H &heap) -> std::vector<index_t> {
+    std::vector<index_t> ret;
+    for (; !heap.empty(); heap.pop()) {
+        ret.emplace_back(heap.top());
+    }
+    return ret;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+TEST_CASE("heap") {
+    SECTION("order") {
+        IndexedHeap<> heap;
+        for (index_t x : {5, 3, 8, 1, 9, 3, 7}) {
+            heap.push(x);
+        }
+        REQUIRE(heap.size() == 6);
+        REQUIRE(heap.contains(3));
+        REQUIRE(!heap.contains(2));
+        REQUIRE(drain(heap) == std::vector<index_t>{1, 3, 5, 7, 8, 9});
+        REQUIRE(!heap.contains(3));
+    }
+    SECTION("remove") {
+        IndexedHeap<> heap;
+        for (index_t x = 0; x < 10; ++x) {
+            heap.push(x);
+        }
+        heap.remove(0);
+        heap.remove(5);
+        heap.remove(9);
+        heap.remove(42);
+        REQUIRE(!heap.contains(5));
+        REQUIRE(drain(heap) == std::vector<index_t>{1, 2, 3, 4, 6, 7, 8});
+    }
+    SECTION("clear") {
+        IndexedHeap<> heap;
+        heap.push(4);
+        heap.push(2);
+        heap.clear();
+        REQUIRE(heap.empty());
+        REQUIRE(!heap.contains(4));
+        heap.push(4);
+        REQUIRE(heap.contains(4));
+        REQUIRE(drain(heap) == std::vector<index_t>{4});
+    }
+    SECTION("update") {
+        std::vector<int> prio{3, 1, 2, 0};
+        auto cmp = [&prio](index_t a, index_t b) { return prio[a] < prio[b]; };
+        IndexedHeap<decltype(cmp)> heap{cmp};
+        for (index_t x = 0; x < prio.size(); ++x) {
+            heap.push(x);
+        }
+        REQUIRE(heap.top() == 3);
+        prio[0] = -1;
+        heap.update(0);
+        prio[3] = 5;
+        heap.update(3);
+        REQUIRE(drain(heap) == std::vector<index_t>{0, 1, 2, 3});
+    }
+}
@@ -3,6 +3,10 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 TEST_CASE("number") {
     RationalQ a{Rational(4), Rational(3)};
@@ -30,4 +34,27 @@ TEST_CASE("number") {
     REQUIRE((a /= c) == RationalQ{4, 3});
 
     REQUIRE_THROWS(Rational{"xxx", 10});
+
+    REQUIRE(a.c() == Rational{4});
+    REQUIRE(a.k() == Rational{3});
+    REQUIRE(Integer{-7}.as_int64() == -7);
+    REQUIRE(!Integer{"123456789012345678901234567890", 10}.as_int64().has_value());
+    // Values just above 2^31 do not fit into 32 bit integers.
+    REQUIRE(Integer{"2147483649", 10}.as_int64() == int64_t{2147483649});
+    REQUIRE(Integer{"-2147483649", 10}.as_int64() == int64_t{-2147483649});
+    REQUIRE(Integer::from_int64(int64_t{2147483649}) == Integer{"2147483649", 10});
+    REQUIRE(Integer::from_int64(int64_t{-2147483649}) == Integer{"-2147483649", 10});
+    REQUIRE(Integer{"9223372036854775807", 10}.as_int64() == std::numeric_limits<int64_t>::max());
+    REQUIRE(Integer{"-9223372036854775808", 10}.as_int64() == std::numeric_limits<int64_t>::min());
+    REQUIRE(!Integer{"9223372036854775808", 10}.as_int64().has_value());
+    REQUIRE(!Integer{"-9223372036854775809", 10}.as_int64().has_value());
+    REQUIRE(Integer::from_int64(std::numeric_limits<int64_t>::min()) == Integer{"-9223372036854775808", 10});
+
+    REQUIRE(Rational{0}.as_double() == 0);
+    REQUIRE(Rational{"-3/4", 10}.as_double() == -0.75);
+    REQUIRE(Rational{"1/3", 10}.as_double() == 1.0 / 3);
+    auto big = Rational{"123456789012345678901234567890/7", 10}.as_double();
+    REQUIRE(std::abs(big - (123456789012345678901234567890.0 / 7)) <= 1e-15 * big);
+    auto small = Rational{"-7/123456789012345678901234567890", 10}.as_double();
+    REQUIRE(std::abs(small - (-7 / 123456789012345678901234567890.0)) <= -1e-15 * small);
 }
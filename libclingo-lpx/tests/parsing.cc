@@ -98,4 +98,31 @@ TEST_CASE("parsing") {
         REQUIRE(objective.empty());
         REQUIRE(str(eqs.front()) == "x = 123");
     }
+
+    SECTION("threads") {
+        ctl.add("base", {},
+                "{ a(1..3) }.\n"
+                "&sum { x(X); y : a(1) } >= X :- X = 1..5.\n"
+                "&dom { 0..X } = z(X) :- X = 1..3.\n"
+                "&minimize { x(X) : a(X) }.\n");
+        ctl.ground({{"base", {}}});
+
+        auto evaluate = [&](size_t threads) {
+            VarMap vars;
+            std::vector<Inequality> eqs;
+            std::vector<Term> objective;
+            evaluate_theory(ctl.theory_atoms(), mapper, vars, eqs, objective, threads);
+            std::vector<std::string> res;
+            res.reserve(eqs.size() + 1);
+            for (auto const &eq : eqs) {
+                res.emplace_back(str(eq));
+            }
+            res.emplace_back(str(Inequality{objective, 0, Relation::Equal, 0}));
+            return res;
+        };
+        auto expected = evaluate(1);
+        REQUIRE(expected.size() == 20);
+        REQUIRE(evaluate(3) == expected);
+        REQUIRE(evaluate(64) == expected);
+    }
 }
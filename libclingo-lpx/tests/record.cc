@@ -0,0 +1,75 @@
+#include "record.hh"
+#include "solving.hh"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <clingo.hh>
+#include <cstdio>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+TEST_CASE("record") {
+    auto filename = (std::filesystem::temp_directory_path() / "clingo-lpx-test.rec").string();
+    SECTION("entries") {
+        std::vector<Clingo::literal_t> lits{2, -3, 4};
+        RecordWriter writer;
+        writer.open(filename, true);
+        writer.solve(1, 2, {lits.data(), lits.size()}, false);
+        writer.undo(1, 2);
+        writer.check(0, 1);
+        writer.close();
+
+        RecordReader reader{filename};
+        REQUIRE(reader.strict());
+        RecordEntry entry;
+        REQUIRE(reader.read(entry));
+        REQUIRE(entry.tag == RecordTag::Solve);
+        REQUIRE(entry.thread_id == 1);
+        REQUIRE(entry.level == 2);
+        REQUIRE(entry.literals == lits);
+        REQUIRE(!entry.result);
+        REQUIRE(reader.read(entry));
+        REQUIRE(entry.tag == RecordTag::Undo);
+        REQUIRE(entry.thread_id == 1);
+        REQUIRE(entry.level == 2);
+        REQUIRE(reader.read(entry));
+        REQUIRE(entry.tag == RecordTag::Check);
+        REQUIRE(entry.thread_id == 0);
+        REQUIRE(entry.level == 1);
+        REQUIRE(!reader.read(entry));
+    }
+    SECTION("propagator") {
+        Options opts;
+        opts.record = filename;
+        {
+            Propagator<Rational, Tableau> prp{opts};
+            Clingo::Control ctl{{"0"}};
+            prp.register_control(ctl);
+            ctl.add("base", {}, "{ a }. &sum { x } >= 2 :- a. &sum { x; y } <= 1. &sum { y } >= 0.");
+            ctl.ground({{"base", {}}});
+            auto h = ctl.solve();
+            REQUIRE(std::distance(begin(h), end(h)) == 1);
+            prp.finish();
+        }
+
+        RecordReader reader{filename};
+        REQUIRE(!reader.strict());
+        RecordEntry entry;
+        REQUIRE(reader.read(entry));
+        REQUIRE(entry.tag == RecordTag::Init);
+        REQUIRE(entry.n_threads == 1);
+        REQUIRE(entry.offset == 0);
+        REQUIRE(!entry.inequalities.empty());
+        size_t n_check = 0;
+        while (reader.read(entry)) {
+            REQUIRE(entry.tag != RecordTag::Init);
+            REQUIRE(entry.thread_id == 0);
+            n_check += entry.tag == RecordTag::Check ? 1 : 0;
+        }
+        REQUIRE(n_check > 0);
+    }
+    std::remove(filename.c_str());
+}
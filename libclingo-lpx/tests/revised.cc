@@ -0,0 +1,141 @@
+#include "revised.hh"
+#include "tableau.hh"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+template <typename T> auto as_num_mat(T const &tab, index_t m, index_t n) -> std::vector<std::vector<Rational>> {
+    std::vector<std::vector<Rational>> ret;
+    ret.reserve(m);
+    for (index_t i = 0; i < m; ++i) {
+        ret.emplace_back();
+        auto &row = ret.back();
+        row.reserve(n);
+        for (index_t j = 0; j < n; ++j) {
+            row.emplace_back(tab.get(i, j));
+        }
+    }
+    return ret;
+}
+
+template <typename T> auto row_mat(T &tab, index_t m, index_t n) -> std::vector<std::vector<Rational>> {
+    std::vector<std::vector<Rational>> ret(m, std::vector<Rational>(n));
+    for (index_t i = 0; i < m; ++i) {
+        tab.update_row(i, [&](index_t j, Integer const &num, Integer const &den) { ret[i][j] = Rational{num, den}; });
+    }
+    return ret;
+}
+
+template <typename T> auto col_mat(T &tab, index_t m, index_t n) -> std::vector<std::vector<Rational>> {
+    std::vector<std::vector<Rational>> ret(m, std::vector<Rational>(n));
+    for (index_t j = 0; j < n; ++j) {
+        tab.update_col(j, [&](index_t i, Integer const &num, Integer const &den) { ret[i][j] = Rational{num, den}; });
+    }
+    return ret;
+}
+
+} // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+TEST_CASE("revised") {
+    RevisedTableau rev;
+
+    SECTION("integer") {
+        REQUIRE(rev.empty());
+        REQUIRE(rev.get(0, 0) == 0);
+        rev.set(0, 2, 1);
+        REQUIRE(!rev.empty());
+        REQUIRE(rev.get(0, 2) == 1);
+        size_t n = 0;
+        rev.update_row(0, [&n](index_t j, Integer const &a_0j, Integer const &d_0) {
+            REQUIRE(j == 2);
+            REQUIRE(a_0j == 1);
+            REQUIRE(d_0 == 1);
+            ++n;
+        });
+        REQUIRE(n == 1);
+        rev.set(0, 2, 0);
+        REQUIRE(rev.empty());
+    }
+
+    SECTION("pivot") {
+        for (index_t i = 0; i < 3; ++i) {
+            for (index_t j = 0; j < 3; ++j) {
+                rev.set(i, j, Rational{static_cast<fixed_int>((3 * i) + j + 1)});
+            }
+        }
+
+        Integer *num = nullptr;
+        Integer *den = nullptr;
+        rev.unsafe_get(1, 1, num, den);
+        REQUIRE(Rational{*num, *den} == 5);
+        rev.pivot(1, 1, *num, *den);
+
+        std::vector<std::vector<Rational>> num_sol = {
+            {{-3, 5}, {2, 5}, {3, 5}}, {{-4, 5}, {1, 5}, {-6, 5}}, {{3, 5}, {8, 5}, {-3, 5}}};
+        REQUIRE(as_num_mat(rev, 3, 3) == num_sol);
+        REQUIRE(row_mat(rev, 3, 3) == num_sol);
+        REQUIRE(col_mat(rev, 3, 3) == num_sol);
+
+        rev.refactor();
+        REQUIRE(as_num_mat(rev, 3, 3) == num_sol);
+        REQUIRE(col_mat(rev, 3, 3) == num_sol);
+
+        rev.clear_col(1);
+        num_sol = {{{-3, 5}, {}, {3, 5}}, {{-4, 5}, {}, {-6, 5}}, {{3, 5}, {}, {-3, 5}}};
+        REQUIRE(as_num_mat(rev, 3, 3) == num_sol);
+        REQUIRE(row_mat(rev, 3, 3) == num_sol);
+        REQUIRE(col_mat(rev, 3, 3) == num_sol);
+        REQUIRE(rev.col_size(1) == 0);
+    }
+
+    SECTION("tableau") {
+        // pivot a sparse tableau and its revised counterpart well beyond the
+        // refactorization interval and compare the results
+        index_t const m = 12;
+        index_t const n = 9;
+        Tableau tab;
+        uint32_t seed = 17;
+        auto next = [&seed]() {
+            seed = (seed * 1103515245U) + 12345U;
+            return (seed >> 16U) & 0x7fffU;
+        };
+        for (index_t i = 0; i < m; ++i) {
+            for (index_t j = 0; j < n; ++j) {
+                if (next() % 3 == 0 || i % n == j) {
+                    auto a = Rational{static_cast<fixed_int>(next() % 7) - 3};
+                    if (a == 0) {
+                        a = 1;
+                    }
+                    tab.set(i, j, a);
+                    rev.set(i, j, a);
+                }
+            }
+        }
+        for (size_t k = 0; k < 3 * RevisedTableau::refactor_interval; ++k) {
+            auto i = static_cast<index_t>(next() % m);
+            std::vector<index_t> cols;
+            tab.update_row(i, [&cols](index_t j, Integer const &a_ij, Integer const &d_i) {
+                static_cast<void>(a_ij);
+                static_cast<void>(d_i);
+                cols.emplace_back(j);
+            });
+            if (cols.empty()) {
+                continue;
+            }
+            auto j = cols[next() % cols.size()];
+            Integer *num = nullptr;
+            Integer *den = nullptr;
+            tab.unsafe_get(i, j, num, den);
+            tab.pivot(i, j, *num, *den);
+            rev.unsafe_get(i, j, num, den);
+            rev.pivot(i, j, *num, *den);
+        }
+        auto expected = as_num_mat(tab, m, n);
+        REQUIRE(row_mat(rev, m, n) == expected);
+        REQUIRE(col_mat(rev, m, n) == expected);
+    }
+}
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
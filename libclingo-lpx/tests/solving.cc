@@ -3,49 +3,61 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
 #include <clingo.hh>
 #include <iterator>
+#include <map>
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace {
 
-template <typename V> class SHM : public Clingo::SolveEventHandler {
+template <typename V, typename M> class SHM : public Clingo::SolveEventHandler {
   public:
-    SHM(Propagator<V> &prp) : prp_{prp} {}
+    SHM(Propagator<V, M> &prp) : prp_{prp} {}
     auto on_model(Clingo::Model &model) -> bool override {
         prp_.on_model(model);
         val_ = prp_.get_objective(model.thread_id());
+        if (val_.has_value()) {
+            vals_.emplace_back(val_->first);
+        }
         return true;
     }
     auto get_objective() const -> std::optional<std::pair<V, bool>> const & { return val_; }
+    auto get_objectives() const -> std::vector<V> const & { return vals_; }
 
   private:
     std::optional<std::pair<V, bool>> val_;
-    Propagator<V> &prp_;
+    std::vector<V> vals_;
+    Propagator<V, M> &prp_;
 };
 
 Options const options{SelectionHeuristic::Conflict, StoreSATAssignments::Partial, std::nullopt, PropagateMode::Changed,
                       true};
 
-template <typename V = Rational> auto run(char const *s) -> bool {
-    Propagator<V> prp{options};
-    Clingo::Control ctl;
+template <typename V = Rational, typename M = Tableau>
+auto run(char const *s, Options const &opts = options, int threads = 1) -> size_t {
+    Propagator<V, M> prp{opts};
+    Clingo::Control ctl{{"0"}};
+    ctl.configuration()["solve"]["parallel_mode"] = std::to_string(threads).c_str();
     prp.register_control(ctl);
 
     ctl.add("base", {}, s);
     ctl.ground({{"base", {}}});
 
-    return ctl.solve(Clingo::LiteralSpan{}, nullptr, false, false).get().is_satisfiable();
+    auto h = ctl.solve();
+    return static_cast<size_t>(std::distance(begin(h), end(h)));
 }
 
-template <typename V = Rational>
-auto run_o(char const *s, bool global = false, long c = 0, long k = 0) -> std::optional<std::pair<V, bool>> {
-    Options opts = options;
+template <typename V = Rational, typename M = Tableau>
+auto run_o(char const *s, bool global = false, long c = 0, long k = 0, Options opts = options,
+           std::vector<V> *objectives = nullptr) -> std::optional<std::pair<V, bool>> {
     if (global) {
         opts.global_objective = RationalQ{Rational{c}, Rational{k}};
     }
-    Propagator<V> prp{opts};
-    SHM<V> shm{prp};
+    Propagator<V, M> prp{opts};
+    SHM<V, M> shm{prp};
     Clingo::Control ctl;
     if (global) {
         ctl.configuration()["solve"]["models"] = "0";
@@ -55,14 +67,27 @@ auto run_o(char const *s, bool global = false, long c = 0, long k = 0) -> std::o
     ctl.add("base", {}, s);
     ctl.ground({{"base", {}}});
 
-    if (!ctl.solve(Clingo::LiteralSpan{}, &shm, false, false).get().is_satisfiable()) {
+    auto ret = ctl.solve(Clingo::LiteralSpan{}, &shm, false, false).get();
+    if (objectives != nullptr) {
+        *objectives = shm.get_objectives();
+    }
+    if (!ret.is_satisfiable()) {
         return std::nullopt;
     }
     return shm.get_objective();
 }
 
-auto run_m(std::initializer_list<char const *> m) -> size_t {
-    Propagator<Rational> prp{options};
+template <typename V> auto improving(std::vector<V> const &values, V const &step) -> bool {
+    for (size_t i = 1; i < values.size(); ++i) {
+        if (values[i] < values[i - 1] + step) {
+            return false;
+        }
+    }
+    return !values.empty();
+}
+
+auto run_m(std::initializer_list<char const *> m, Options const &opts = options) -> size_t {
+    Propagator<Rational> prp{opts};
     Clingo::Control ctl{{"0"}};
     prp.register_control(ctl);
 
@@ -78,6 +103,65 @@ auto run_m(std::initializer_list<char const *> m) -> size_t {
     return l;
 }
 
+//! Pass the statistics of a solve call to the propagator.
+template <typename V, typename M> class StatsHandler : public Clingo::SolveEventHandler {
+  public:
+    StatsHandler(Propagator<V, M> &prp) : prp_{prp} {}
+    void on_statistics(Clingo::UserStatistics step, Clingo::UserStatistics accu) override {
+        prp_.on_statistics(step, accu);
+    }
+
+  private:
+    Propagator<V, M> &prp_;
+};
+
+using StatsMap = std::map<std::string, double>;
+
+//! Solve the given programs one after the other and return the step and
+//! accumulated statistics of the simplex after each step.
+auto run_s(std::initializer_list<char const *> m, Options const &opts = options)
+    -> std::vector<std::pair<StatsMap, StatsMap>> {
+    Propagator<Rational> prp{opts};
+    StatsHandler<Rational, Tableau> handler{prp};
+    Clingo::Control ctl{{"0", "--stats"}};
+    prp.register_control(ctl);
+
+    auto get = [](Clingo::Statistics const &stats) {
+        StatsMap ret;
+        for (auto const *key : stats.keys()) {
+            ret.emplace(key, stats[key].value());
+        }
+        return ret;
+    };
+    std::vector<std::pair<StatsMap, StatsMap>> ret;
+    int i = 0;
+    for (auto const *s : m) {
+        std::string n = "base" + std::to_string(i++);
+        ctl.add(n.c_str(), {}, s);
+        ctl.ground({{n.c_str(), {}}});
+        ctl.solve(Clingo::LiteralSpan{}, &handler, false, false).get();
+        auto stats = ctl.statistics();
+        ret.emplace_back(get(stats["user_step"]["Simplex"]), get(stats["user_accu"]["Simplex"]));
+    }
+    return ret;
+}
+
+auto run_i(char const *s, std::vector<std::pair<char const *, Inequality>> iqs) -> size_t {
+    Propagator<Rational> prp{options};
+    Clingo::Control ctl{{"0"}};
+    prp.register_control(ctl);
+
+    ctl.add("base", {}, s);
+    ctl.ground({{"base", {}}});
+    for (auto &[atom, iq] : iqs) {
+        iq.lit = ctl.symbolic_atoms().find(Clingo::Id(atom))->literal();
+        prp.add_inequality(std::move(iq));
+    }
+
+    auto h = ctl.solve();
+    return static_cast<size_t>(std::distance(begin(h), end(h)));
+}
+
 constexpr char const *knapsack = R"(
 item(1..5).
 
@@ -159,6 +243,187 @@ TEST_CASE("solving") {
                                 "&sum { y; -z } > 0.\n"
                                 "&sum { z; -x } > 0.\n"));
     }
+    SECTION("revised") {
+        REQUIRE(run<Rational, RevisedTableau>("&sum { x1; x2 } <= 20.\n"
+                                              "&sum { x1; x3 } =   5.\n"
+                                              "&sum { x2; x3 } >= 10.\n"));
+        REQUIRE(!run<Rational, RevisedTableau>("&sum { x; y } >= 2.\n"
+                                               "&sum { x; y } <= 0.\n"
+                                               "&sum {    y } =  0.\n"));
+        REQUIRE(!run<RationalQ, RevisedTableau>("&sum { x; -y } > 0.\n"
+                                                "&sum { y; -z } > 0.\n"
+                                                "&sum { z; -x } > 0.\n"));
+        REQUIRE(run_o<Rational, RevisedTableau>("&sum {   x_1; 2*x_2; 3*x_3 } <= 30.\n"
+                                                "&sum { 2*x_1; 2*x_2; 5*x_3 } <= 24.\n"
+                                                "&sum { 4*x_1;   x_2; 2*x_3 } <= 36.\n"
+                                                "&maximize { 3*x_1; x_2; 2*x_3 }.\n") ==
+                std::make_pair(Rational{378, 13}, true));
+        REQUIRE(run_o<Rational, RevisedTableau>(knapsack, true) == std::make_pair(Rational{180}, true));
+    }
+    SECTION("refresh") {
+        Options opts = options;
+        opts.refresh_factor = 1;
+        opts.refresh_restart = true;
+        REQUIRE(run("&sum {   x;   y } >= 2.\n"
+                    "&sum { 2*x;  -y } >= 0.\n"
+                    "&sum {  -x; 2*y } >= 1.\n",
+                    opts));
+        REQUIRE(!run("&sum { x; y } >= 2.\n"
+                     "&sum { x; y } <= 0.\n"
+                     "&sum {    y } =  0.\n",
+                     opts));
+        REQUIRE(run<Rational, RevisedTableau>("{ a; b }.\n"
+                                              "&sum { x1; x2 } <= 20 :- a.\n"
+                                              "&sum { x1; x3 } =   5 :- b.\n"
+                                              "&sum { x2; x3 } >= 10.\n",
+                                              opts));
+    }
+    SECTION("markowitz") {
+        Options opts = options;
+        opts.entering = EnteringRule::Markowitz;
+        REQUIRE(run("&sum { x1; x2 } <= 20.\n"
+                    "&sum { x1; x3 } =   5.\n"
+                    "&sum { x2; x3 } >= 10.\n",
+                    opts));
+        REQUIRE(!run("&sum { x; y } >= 2.\n"
+                     "&sum { x; y } <= 0.\n"
+                     "&sum {    y } =  0.\n",
+                     opts));
+        REQUIRE(run<Rational, RevisedTableau>("&sum {   x;   y } >= 2.\n"
+                                              "&sum { 2*x;  -y } >= 0.\n"
+                                              "&sum {  -x; 2*y } >= 1.\n",
+                                              opts));
+    }
+    SECTION("components") {
+        Options opts = options;
+        opts.propagate_mode = PropagateMode::Full;
+        REQUIRE(run("{ a; b }.\n"
+                    "&sum { x1; x2 } <= 2 :- a.\n"
+                    "&sum { x1; x2 } >= 3 :- b.\n"
+                    "&sum { y1; y2 } >= 1.\n"
+                    "&sum { y1; -y2 } = 0.\n",
+                    opts));
+        REQUIRE(!run("&sum { x1; x2 } <= 2.\n"
+                     "&sum { x1; x2 } >= 3.\n"
+                     "&sum { y1; y2 } >= 1.\n",
+                     opts));
+    }
+    SECTION("batching") {
+        // Literal a implies bounds on non-basic variables whose updates are
+        // deferred. The conflict caused together with b, detected either
+        // directly or after the deferred updates have been flushed, has to
+        // drop the pending updates.
+        Options opts = options;
+        opts.propagate_mode = PropagateMode::None;
+        for (auto store : {StoreSATAssignments::No, StoreSATAssignments::Partial, StoreSATAssignments::Total}) {
+            opts.store_sat_assignment = store;
+            for (char const *s : {"&sum { x } <= 1 :- b.\n", "&sum { x; y } <= 4 :- b.\n"}) {
+                auto prg = std::string{"{ a; c }.\n"
+                                       "b :- a.\n"
+                                       "&sum { x } >= 2 :- a.\n"
+                                       "&sum { y } >= 3 :- a.\n"
+                                       "&sum { x; y } <= 4 :- c.\n"
+                                       "&sum { x; y } >= 0.\n"} +
+                           s;
+                REQUIRE(run(prg.c_str(), opts) == 2);
+                REQUIRE(run<Rational, RevisedTableau>(prg.c_str(), opts) == 2);
+            }
+        }
+    }
+    SECTION("restore") {
+        // When partially storing satisfying assignments, backtracking has to
+        // restore exactly the last satisfying assignment. This is checked
+        // after each undo in cross-check builds.
+        Options opts = options;
+        for (bool lazy : {false, true}) {
+            opts.lazy_rows = lazy;
+            for (bool eliminate : {false, true}) {
+                opts.eliminate_fixed = eliminate;
+                REQUIRE(run(knapsack, opts) == 13);
+                REQUIRE(run<Rational, RevisedTableau>(knapsack, opts) == 13);
+                REQUIRE(run("{ a; b; c }.\n"
+                            "&sum { x1 } >= 30 :- a.\n"
+                            "&sum { x1; x2 } <= 20 :- b.\n"
+                            "&sum { x2 } >= 0 :- c.\n"
+                            "&sum { x1; x2; x3 } = 5.\n",
+                            opts) == 7);
+                REQUIRE(run<RationalQ>("{ a; b; c }.\n"
+                                       "&sum { x1 } > 30 :- a.\n"
+                                       "&sum { x1; x2 } < 20 :- b.\n"
+                                       "&sum { x2 } > 0 :- c.\n"
+                                       "&sum { x1; x2; x3 } = 5.\n",
+                                       opts) == 7);
+            }
+        }
+    }
+    SECTION("lazy-rows") {
+        Options opts = options;
+        for (bool lazy : {false, true}) {
+            opts.lazy_rows = lazy;
+            REQUIRE(run("{ a; b; c }.\n"
+                        "&sum { x1; x2 } <= 20 :- a.\n"
+                        "&sum { x1; x3 } =   5 :- b.\n"
+                        "&sum { x2; x3 } >= 10 :- c.\n"
+                        ":- not a. :- not b. :- not c.\n",
+                        opts));
+            REQUIRE(!run("{ a; b }.\n"
+                         "&sum { x; y } >= 2 :- a.\n"
+                         "&sum { x; y } <= 0 :- b.\n"
+                         "&sum {    y } =  0.\n"
+                         ":- not a. :- not b.\n",
+                         opts));
+            REQUIRE(run_o("&sum {   x_1; 2*x_2; 3*x_3 } <= 30.\n"
+                          "&sum { 2*x_1; 2*x_2; 5*x_3 } <= 24.\n"
+                          "&sum { 4*x_1;   x_2; 2*x_3 } <= 36.\n"
+                          "&maximize { 3*x_1; x_2; 2*x_3 }.\n",
+                          false, 0, 0, opts) == std::make_pair(Rational{378, 13}, true));
+            REQUIRE(run_m({"{ a; b }.\n"
+                           "&sum { x1; x2 } <= 20 :- a.\n"
+                           "&sum { x1; x2 } >= 10 :- b.\n",
+                           "&sum { x1; x3 } >= 30.\n"
+                           "&sum { x2; x3 } <= 5 :- a.\n",
+                           "{ c }.\n"
+                           "&sum { x1 } <= 5 :- c.\n"
+                           "&sum { x3 } <= 0.\n"},
+                          opts) == 12);
+        }
+    }
+    SECTION("eliminate-fixed") {
+        Options opts = options;
+        for (bool eliminate : {false, true}) {
+            opts.eliminate_fixed = eliminate;
+            REQUIRE(run("{ a }.\n"
+                        "&sum { x } = 3.\n"
+                        "&sum { x; y } <= 5.\n"
+                        "&sum { x; y } >= 4 :- a.\n"
+                        "&sum { y; z } = 7 :- a.\n",
+                        opts));
+            REQUIRE(!run("&sum { x } = 3.\n"
+                         "&sum { x; y } <= 5.\n"
+                         "&sum { y } >= 3.\n",
+                         opts));
+            REQUIRE(run_o("&sum { x } = 2.\n"
+                          "&sum { x; y } <= 5.\n"
+                          "&sum { y; z } <= 4.\n"
+                          "&maximize { x; y; z }.\n",
+                          false, 0, 0, opts) == std::make_pair(Rational{6}, true));
+            REQUIRE(run_o<Rational, RevisedTableau>("&sum { x } = 2.\n"
+                                                    "&sum { x; y } <= 5.\n"
+                                                    "&sum { y; z } <= 4.\n"
+                                                    "&maximize { x; y; z }.\n",
+                                                    false, 0, 0, opts) == std::make_pair(Rational{6}, true));
+            // Variable y becomes basic and is shifted when x is eliminated.
+            // With a, it leaves the basis keeping its offset, which has to be
+            // respected when adding a row over y in the next step.
+            REQUIRE(run_m({"{ a }.\n"
+                           "&sum { x } = 2.\n"
+                           "&sum { x; y } >= 5.\n"
+                           "&sum { y } >= 4 :- a.\n",
+                           "{ b }.\n"
+                           "&sum { x; y } <= 5 :- b.\n"},
+                          opts) == 2 + 3);
+        }
+    }
     SECTION("multi-shot") {
         REQUIRE(run_m({"&sum { x1; x2 } <= 20.\n"
                        "&sum { x1; x2 } >= 10.\n",
@@ -170,6 +435,78 @@ TEST_CASE("solving") {
                        "&sum { x1: a; x2: b } >= 10.\n",
                        ":- a.\n"
                        ":- b."}) == 3);
+        REQUIRE(run_m({"&sum { x } = 2.\n"
+                       "&sum { x; y } >= 5.\n",
+                       "&sum { x; y; z } <= 6.\n"
+                       "&sum { z } >= 1.\n",
+                       "&sum { z } >= 2.\n"}) == 2);
+    }
+    SECTION("statistics") {
+        // Counters and timers are summed over steps while gauges take the
+        // maximum.
+        auto stats = run_s({knapsack, ":- pack(1).\n", "&sum { pack(2); pack(3) } <= 1.\n"});
+        REQUIRE(stats.size() == 3);
+        std::vector<char const *> sums{"Pivots", "Bounds propagated", "Refreshes", "Nonzeros before refresh",
+                                       "Nonzeros after refresh", "Conflicts", "Conflict literals",
+                                       "Columns eliminated", "Nonzeros eliminated", "Time solve", "Time propagate"};
+#ifdef CLINGOLPX_TIMERS
+        sums.insert(sums.end(), {"Time select", "Time pivot", "Time optimize", "Time undo"});
+#endif
+        std::vector<char const *> maxs{"Components", "Conflict queue max", "Propagate queue max", "Nonzeros",
+                                       "Coefficient bits max"};
+        StatsMap prev;
+        for (auto const &[step, accu] : stats) {
+            for (auto const *key : sums) {
+                REQUIRE(step.count(key) == 1);
+                REQUIRE(accu.count(key) == 1);
+                REQUIRE(accu.at(key) == prev[key] + step.at(key));
+            }
+            for (auto const *key : maxs) {
+                REQUIRE(step.count(key) == 1);
+                REQUIRE(accu.count(key) == 1);
+                REQUIRE(accu.at(key) == std::max(prev[key], step.at(key)));
+            }
+            prev = accu;
+        }
+        REQUIRE(prev["Pivots"] > 0);
+        REQUIRE(prev["Conflicts"] > 0);
+        REQUIRE(prev["Nonzeros"] > 0);
+        REQUIRE(stats.back().first.at("Pivots") < prev["Pivots"]);
+    }
+    SECTION("add-inequality") {
+        auto x = Clingo::Id("x");
+        auto y = Clingo::Id("y");
+        REQUIRE(run_i("{ a }. b.", {{"a", Inequality{{{1, x}}, 2, Relation::GreaterEqual, 0}},
+                                     {"b", Inequality{{{1, x}, {1, y}}, 0, Relation::LessEqual, 0}},
+                                     {"b", Inequality{{{1, y}}, 0, Relation::Equal, 0}}}) == 1);
+        REQUIRE(run_i("{ a; b }.", {{"a", Inequality{{{1, x}, {1, x}}, 4, Relation::GreaterEqual, 0}},
+                                     {"b", Inequality{{{1, x}}, 1, Relation::LessEqual, 0}}}) == 3);
+        REQUIRE_THROWS(run_i("a.", {{"a", Inequality{{{1, Clingo::Number(1)}}, 0, Relation::Equal, 0}}}));
+        REQUIRE_THROWS(run_i("a.", {{"a", Inequality{{{1, x}}, 0, Relation::Less, 0}}}));
+    }
+    SECTION("parallel") {
+        Options opts = options;
+        opts.share_facts = true;
+        REQUIRE(run("{ a; b; c }.\n"
+                    "&sum { x } >= 2 :- a.\n"
+                    "&sum { x } <= 1 :- b.\n"
+                    "&sum { x; y } <= 0 :- c.\n"
+                    "&sum { y } >= 0.\n",
+                    opts, 4) == 5);
+        REQUIRE(run("&sum { x1; x2 } <= 20.\n"
+                    "&sum { x1; x3 } =   5.\n"
+                    "&sum { x2; x3 } >= 10.\n",
+                    opts, 4) == 1);
+        REQUIRE(run("&sum { x; y } >= 2.\n"
+                    "&sum { x; y } <= 0.\n",
+                    opts, 4) == 0);
+        opts.portfolio = Portfolio::Mixed;
+        REQUIRE(run("{ a; b; c }.\n"
+                    "&sum { x } >= 2 :- a.\n"
+                    "&sum { x } <= 1 :- b.\n"
+                    "&sum { x; y } <= 0 :- c.\n"
+                    "&sum { y } >= 0.\n",
+                    opts, 4) == 5);
     }
     SECTION("optimize") {
         REQUIRE(run_o("&sum {   x_1; 2*x_2; 3*x_3 } <= 30.\n"
@@ -209,4 +546,30 @@ TEST_CASE("solving") {
         REQUIRE(run_o(knapsack, true) == std::make_pair(Rational{180}, true));
         REQUIRE(run_o<RationalQ>(knapsack, true, 0, 1) == std::make_pair(RationalQ{Rational{180}}, true));
     }
+    SECTION("optimize-tighten") {
+        // The bound on the objective is tightened in place. Each model has to
+        // improve on the previous one by at least the step like with a fresh
+        // bound per model.
+        Options opts = options;
+        for (auto store : {StoreSATAssignments::No, StoreSATAssignments::Partial, StoreSATAssignments::Total}) {
+            opts.store_sat_assignment = store;
+            std::vector<Rational> objs;
+            REQUIRE(run_o(knapsack, true, 10, 0, opts, &objs) == std::make_pair(Rational{180}, true));
+            REQUIRE(improving(objs, Rational{10}));
+            REQUIRE(run_o<Rational, RevisedTableau>(knapsack, true, 10, 0, opts, &objs) ==
+                    std::make_pair(Rational{180}, true));
+            REQUIRE(improving(objs, Rational{10}));
+            std::vector<RationalQ> objs_q;
+            REQUIRE(run_o<RationalQ>(knapsack, true, 0, 1, opts, &objs_q) ==
+                    std::make_pair(RationalQ{Rational{180}}, true));
+            REQUIRE(improving(objs_q, RationalQ{Rational{0}, Rational{1}}));
+            REQUIRE(run_o("{ a; b }.\n"
+                          "&sum { a; b } <= 5.\n"
+                          "&sum { a } <= 2 :- a.\n"
+                          "&sum { b } <= 2 :- b.\n"
+                          "&maximize { a; b }.\n",
+                          true, 1, 0, opts, &objs) == std::make_pair(Rational{5}, true));
+            REQUIRE(improving(objs, Rational{1}));
+        }
+    }
 }
@@ -71,6 +71,9 @@ TEST_CASE("matrix") {
         tab.unsafe_get(0, 4, num, den);
         REQUIRE(*num == 7);
         REQUIRE(*den == (2L * 3 * 5 * 7));
+
+        // the denominator 210 needs 8 bits
+        REQUIRE(tab.bits() == 8);
     }
 
     SECTION("integer") {
@@ -113,6 +116,10 @@ TEST_CASE("matrix") {
         });
         REQUIRE(tab.size() == 1);
 
+        // the column index is cleaned up lazily
+        REQUIRE(tab.col_size(2) == 1);
+        REQUIRE(tab.col_size(0) == 1);
+
         // traverse the first column
         size_t n = 0;
         tab.update_col(0, [&n](index_t i, Integer &a_i0, Integer &d_i) {
@@ -123,6 +130,7 @@ TEST_CASE("matrix") {
         });
         REQUIRE(n == 0);
         REQUIRE(tab.size() == 1);
+        REQUIRE(tab.col_size(0) == 0);
     }
 
     SECTION("pivot") {
@@ -156,6 +164,11 @@ TEST_CASE("matrix") {
 
         REQUIRE(num_ret == num_sol);
         REQUIRE(int_ret == int_sol);
+
+        tab.clear_col(1);
+        num_sol = {{{-3, 5}, {}, {3, 5}}, {{-4, 5}, {}, {-6, 5}}, {{3, 5}, {}, {-3, 5}}};
+        REQUIRE(as_num_mat(tab, 3, 3) == num_sol);
+        REQUIRE(tab.col_size(1) == 0);
     }
 }
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
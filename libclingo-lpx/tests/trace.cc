@@ -0,0 +1,68 @@
+#include "trace.hh"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+TEST_CASE("trace") {
+    Trace trace;
+    std::ostringstream oss;
+    SECTION("disabled") {
+        REQUIRE(trace.buffer(0) == nullptr);
+        trace.flush();
+        trace.close();
+        REQUIRE(oss.str().empty());
+    }
+    SECTION("enabled") {
+        trace.enable(oss);
+        auto *buffer = trace.buffer(1);
+        REQUIRE(buffer != nullptr);
+        REQUIRE(trace.buffer(1) == buffer);
+        { TraceScope scope{buffer, "solve"}; }
+        trace.close();
+        auto str = oss.str();
+        REQUIRE(str.substr(0, 2) == "[\n");
+        REQUIRE(str.substr(str.size() - 3) == "\n]\n");
+        REQUIRE(str.find("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,") != std::string::npos);
+        REQUIRE(str.find("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,") != std::string::npos);
+        auto begin = str.find("{\"name\":\"solve\",\"ph\":\"B\",\"ts\":");
+        auto end = str.find("{\"name\":\"solve\",\"ph\":\"E\",\"ts\":");
+        REQUIRE(begin != std::string::npos);
+        REQUIRE(end != std::string::npos);
+        REQUIRE(begin < end);
+        REQUIRE(str.find(",\"pid\":1,\"tid\":1}", begin) != std::string::npos);
+        REQUIRE(trace.buffer(0) == nullptr);
+    }
+    SECTION("flush") {
+        trace.enable(oss);
+        auto *buffer = trace.buffer(0);
+        { TraceScope scope{buffer, "solve"}; }
+        trace.flush();
+        auto str = oss.str();
+        REQUIRE(str.find("\"ph\":\"E\"") != std::string::npos);
+        { TraceScope scope{buffer, "undo"}; }
+        trace.flush();
+        // flushed events are not written again
+        str = oss.str();
+        REQUIRE(str.find("\"solve\",\"ph\":\"B\"") == str.rfind("\"solve\",\"ph\":\"B\""));
+        REQUIRE(str.find("thread_name") == str.rfind("thread_name"));
+        REQUIRE(str.find("undo") != std::string::npos);
+    }
+    SECTION("cap") {
+        trace.enable(oss);
+        auto *buffer = trace.buffer(0);
+        {
+            TraceScope outer{buffer, "outer"};
+            for (size_t i = 0; i != TraceBuffer::max_events; ++i) {
+                TraceScope inner{buffer, "inner"};
+            }
+        }
+        trace.close();
+        auto str = oss.str();
+        // the outer scope and half of the inner scopes fit into the buffer
+        REQUIRE(str.find("{\"name\":\"outer\",\"ph\":\"E\"") != std::string::npos);
+        REQUIRE(str.find("\"args\":{\"count\":" + std::to_string(TraceBuffer::max_events) + "}") !=
+                std::string::npos);
+    }
+}
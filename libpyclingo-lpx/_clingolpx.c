@@ -543,95 +543,174 @@ static void (*_cffi_call_python_org)(struct _cffi_externpy_s *, char *);
 /************************************************************/
 
 static void *_cffi_types[] = {
-/*  0 */ _CFFI_OP(_CFFI_OP_FUNCTION, 73), // _Bool()(clingo_ast_t *, void *)
-/*  1 */ _CFFI_OP(_CFFI_OP_POINTER, 76), // clingo_ast_t *
-/*  2 */ _CFFI_OP(_CFFI_OP_POINTER, 86), // void *
+/*  0 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingo_ast_t *, void *)
+/*  1 */ _CFFI_OP(_CFFI_OP_POINTER, 119), // clingo_ast_t *
+/*  2 */ _CFFI_OP(_CFFI_OP_POINTER, 130), // void *
 /*  3 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/*  4 */ _CFFI_OP(_CFFI_OP_FUNCTION, 73), // _Bool()(clingolpx_theory_t * *)
+/*  4 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t * *)
 /*  5 */ _CFFI_OP(_CFFI_OP_POINTER, 8), // clingolpx_theory_t * *
 /*  6 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/*  7 */ _CFFI_OP(_CFFI_OP_FUNCTION, 73), // _Bool()(clingolpx_theory_t *)
-/*  8 */ _CFFI_OP(_CFFI_OP_POINTER, 81), // clingolpx_theory_t *
+/*  7 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *)
+/*  8 */ _CFFI_OP(_CFFI_OP_POINTER, 125), // clingolpx_theory_t *
 /*  9 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 10 */ _CFFI_OP(_CFFI_OP_FUNCTION, 73), // _Bool()(clingolpx_theory_t *, char const *, char const *)
+/* 10 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, char const *, char const *)
 /* 11 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
-/* 12 */ _CFFI_OP(_CFFI_OP_POINTER, 74), // char const *
+/* 12 */ _CFFI_OP(_CFFI_OP_POINTER, 117), // char const *
 /* 13 */ _CFFI_OP(_CFFI_OP_NOOP, 12),
 /* 14 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 15 */ _CFFI_OP(_CFFI_OP_FUNCTION, 73), // _Bool()(clingolpx_theory_t *, clingo_ast_t *, _Bool(*)(clingo_ast_t *, void *), void *)
+/* 15 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, clingo_ast_t *, _Bool(*)(clingo_ast_t *, void *), void *)
 /* 16 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
 /* 17 */ _CFFI_OP(_CFFI_OP_NOOP, 1),
 /* 18 */ _CFFI_OP(_CFFI_OP_POINTER, 0), // _Bool(*)(clingo_ast_t *, void *)
 /* 19 */ _CFFI_OP(_CFFI_OP_NOOP, 2),
 /* 20 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 21 */ _CFFI_OP(_CFFI_OP_FUNCTION, 73), // _Bool()(clingolpx_theory_t *, clingo_control_t *)
+/* 21 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, clingo_control_t *)
 /* 22 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
-/* 23 */ _CFFI_OP(_CFFI_OP_POINTER, 77), // clingo_control_t *
+/* 23 */ _CFFI_OP(_CFFI_OP_POINTER, 120), // clingo_control_t *
 /* 24 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 25 */ _CFFI_OP(_CFFI_OP_FUNCTION, 73), // _Bool()(clingolpx_theory_t *, clingo_model_t *)
+/* 25 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, clingo_model_t *)
 /* 26 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
-/* 27 */ _CFFI_OP(_CFFI_OP_POINTER, 78), // clingo_model_t *
+/* 27 */ _CFFI_OP(_CFFI_OP_POINTER, 121), // clingo_model_t *
 /* 28 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 29 */ _CFFI_OP(_CFFI_OP_FUNCTION, 73), // _Bool()(clingolpx_theory_t *, clingo_options_t *)
+/* 29 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, clingo_options_t *)
 /* 30 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
-/* 31 */ _CFFI_OP(_CFFI_OP_POINTER, 79), // clingo_options_t *
+/* 31 */ _CFFI_OP(_CFFI_OP_POINTER, 122), // clingo_options_t *
 /* 32 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 33 */ _CFFI_OP(_CFFI_OP_FUNCTION, 73), // _Bool()(clingolpx_theory_t *, clingo_statistics_t *, clingo_statistics_t *)
+/* 33 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, clingo_statistics_t *, clingo_statistics_t *)
 /* 34 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
-/* 35 */ _CFFI_OP(_CFFI_OP_POINTER, 80), // clingo_statistics_t *
+/* 35 */ _CFFI_OP(_CFFI_OP_POINTER, 123), // clingo_statistics_t *
 /* 36 */ _CFFI_OP(_CFFI_OP_NOOP, 35),
 /* 37 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 38 */ _CFFI_OP(_CFFI_OP_FUNCTION, 73), // _Bool()(clingolpx_theory_t *, uint32_t, size_t *)
+/* 38 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, int32_t, uint64_t const *, int64_t const *, int64_t const *, size_t, int, int64_t, int64_t)
 /* 39 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
-/* 40 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 22), // uint32_t
-/* 41 */ _CFFI_OP(_CFFI_OP_POINTER, 46), // size_t *
-/* 42 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 43 */ _CFFI_OP(_CFFI_OP_FUNCTION, 73), // _Bool()(clingolpx_theory_t *, uint32_t, size_t)
-/* 44 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
-/* 45 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 22),
-/* 46 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 28), // size_t
-/* 47 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 48 */ _CFFI_OP(_CFFI_OP_FUNCTION, 73), // _Bool()(clingolpx_theory_t *, uint64_t, size_t *)
-/* 49 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
-/* 50 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 24), // uint64_t
-/* 51 */ _CFFI_OP(_CFFI_OP_NOOP, 41),
-/* 52 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 53 */ _CFFI_OP(_CFFI_OP_FUNCTION, 50), // uint64_t()(clingolpx_theory_t *, size_t)
-/* 54 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
-/* 55 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 28),
-/* 56 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 57 */ _CFFI_OP(_CFFI_OP_FUNCTION, 86), // void()(clingolpx_theory_t *, uint32_t, size_t *)
-/* 58 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
-/* 59 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 22),
-/* 60 */ _CFFI_OP(_CFFI_OP_NOOP, 41),
-/* 61 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 62 */ _CFFI_OP(_CFFI_OP_FUNCTION, 86), // void()(clingolpx_theory_t *, uint32_t, size_t, clingolpx_value_t *)
-/* 63 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
-/* 64 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 22),
-/* 65 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 28),
-/* 66 */ _CFFI_OP(_CFFI_OP_POINTER, 82), // clingolpx_value_t *
-/* 67 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 68 */ _CFFI_OP(_CFFI_OP_FUNCTION, 86), // void()(int *, int *, int *)
-/* 69 */ _CFFI_OP(_CFFI_OP_POINTER, 85), // int *
-/* 70 */ _CFFI_OP(_CFFI_OP_NOOP, 69),
-/* 71 */ _CFFI_OP(_CFFI_OP_NOOP, 69),
-/* 72 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
-/* 73 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 1), // _Bool
-/* 74 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 2), // char
-/* 75 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 1), // clingo_ast_statement_t
-/* 76 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 0), // clingo_ast_t
-/* 77 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 2), // clingo_control_t
-/* 78 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 3), // clingo_model_t
-/* 79 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 4), // clingo_options_t
-/* 80 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 5), // clingo_statistics_t
-/* 81 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 6), // clingolpx_theory_t
-/* 82 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 7), // clingolpx_value_t
-/* 83 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 14), // double
-/* 84 */ _CFFI_OP(_CFFI_OP_ENUM, 0), // enum clingolpx_value_type
-/* 85 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 7), // int
-/* 86 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 0), // void
+/* 40 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 21), // int32_t
+/* 41 */ _CFFI_OP(_CFFI_OP_POINTER, 89), // uint64_t const *
+/* 42 */ _CFFI_OP(_CFFI_OP_POINTER, 46), // int64_t const *
+/* 43 */ _CFFI_OP(_CFFI_OP_NOOP, 42),
+/* 44 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 28), // size_t
+/* 45 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 7), // int
+/* 46 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 23), // int64_t
+/* 47 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 23),
+/* 48 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 49 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, uint32_t, _Bool *, clingolpx_value_t *, _Bool *)
+/* 50 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
+/* 51 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 22), // uint32_t
+/* 52 */ _CFFI_OP(_CFFI_OP_POINTER, 116), // _Bool *
+/* 53 */ _CFFI_OP(_CFFI_OP_POINTER, 126), // clingolpx_value_t *
+/* 54 */ _CFFI_OP(_CFFI_OP_NOOP, 52),
+/* 55 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 56 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, uint32_t, size_t *)
+/* 57 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
+/* 58 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 22),
+/* 59 */ _CFFI_OP(_CFFI_OP_POINTER, 44), // size_t *
+/* 60 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 61 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, uint32_t, size_t const * *, size_t *)
+/* 62 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
+/* 63 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 22),
+/* 64 */ _CFFI_OP(_CFFI_OP_POINTER, 70), // size_t const * *
+/* 65 */ _CFFI_OP(_CFFI_OP_NOOP, 59),
+/* 66 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 67 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, uint32_t, size_t const *, size_t, clingolpx_rational_t *)
+/* 68 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
+/* 69 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 22),
+/* 70 */ _CFFI_OP(_CFFI_OP_POINTER, 44), // size_t const *
+/* 71 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 28),
+/* 72 */ _CFFI_OP(_CFFI_OP_POINTER, 124), // clingolpx_rational_t *
+/* 73 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 74 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, uint32_t, size_t)
+/* 75 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
+/* 76 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 22),
+/* 77 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 28),
+/* 78 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 79 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, uint32_t, size_t, int64_t *, int64_t *, double *)
+/* 80 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
+/* 81 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 22),
+/* 82 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 28),
+/* 83 */ _CFFI_OP(_CFFI_OP_POINTER, 46), // int64_t *
+/* 84 */ _CFFI_OP(_CFFI_OP_NOOP, 83),
+/* 85 */ _CFFI_OP(_CFFI_OP_POINTER, 127), // double *
+/* 86 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 87 */ _CFFI_OP(_CFFI_OP_FUNCTION, 116), // _Bool()(clingolpx_theory_t *, uint64_t, size_t *)
+/* 88 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
+/* 89 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 24), // uint64_t
+/* 90 */ _CFFI_OP(_CFFI_OP_NOOP, 59),
+/* 91 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 92 */ _CFFI_OP(_CFFI_OP_FUNCTION, 44), // size_t()(clingolpx_theory_t *, uint32_t)
+/* 93 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
+/* 94 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 22),
+/* 95 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 96 */ _CFFI_OP(_CFFI_OP_FUNCTION, 89), // uint64_t()(clingolpx_theory_t *, size_t)
+/* 97 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
+/* 98 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 28),
+/* 99 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 100 */ _CFFI_OP(_CFFI_OP_FUNCTION, 130), // void()(clingolpx_theory_t *, uint32_t, size_t *)
+/* 101 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
+/* 102 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 22),
+/* 103 */ _CFFI_OP(_CFFI_OP_NOOP, 59),
+/* 104 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 105 */ _CFFI_OP(_CFFI_OP_FUNCTION, 130), // void()(clingolpx_theory_t *, uint32_t, size_t, clingolpx_value_t *)
+/* 106 */ _CFFI_OP(_CFFI_OP_NOOP, 8),
+/* 107 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 22),
+/* 108 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 28),
+/* 109 */ _CFFI_OP(_CFFI_OP_NOOP, 53),
+/* 110 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 111 */ _CFFI_OP(_CFFI_OP_FUNCTION, 130), // void()(int *, int *, int *)
+/* 112 */ _CFFI_OP(_CFFI_OP_POINTER, 45), // int *
+/* 113 */ _CFFI_OP(_CFFI_OP_NOOP, 112),
+/* 114 */ _CFFI_OP(_CFFI_OP_NOOP, 112),
+/* 115 */ _CFFI_OP(_CFFI_OP_FUNCTION_END, 0),
+/* 116 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 1), // _Bool
+/* 117 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 2), // char
+/* 118 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 1), // clingo_ast_statement_t
+/* 119 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 0), // clingo_ast_t
+/* 120 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 2), // clingo_control_t
+/* 121 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 3), // clingo_model_t
+/* 122 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 4), // clingo_options_t
+/* 123 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 5), // clingo_statistics_t
+/* 124 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 6), // clingolpx_rational_t
+/* 125 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 7), // clingolpx_theory_t
+/* 126 */ _CFFI_OP(_CFFI_OP_STRUCT_UNION, 8), // clingolpx_value_t
+/* 127 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 14), // double
+/* 128 */ _CFFI_OP(_CFFI_OP_ENUM, 0), // enum clingolpx_relation
+/* 129 */ _CFFI_OP(_CFFI_OP_ENUM, 1), // enum clingolpx_value_type
+/* 130 */ _CFFI_OP(_CFFI_OP_PRIMITIVE, 0), // void
 };
 
+static int _cffi_const_clingolpx_relation_less_equal(unsigned long long *o)
+{
+  int n = (clingolpx_relation_less_equal) <= 0;
+  *o = (unsigned long long)((clingolpx_relation_less_equal) | 0);  /* check that clingolpx_relation_less_equal is an integer */
+  return n;
+}
+
+static int _cffi_const_clingolpx_relation_greater_equal(unsigned long long *o)
+{
+  int n = (clingolpx_relation_greater_equal) <= 0;
+  *o = (unsigned long long)((clingolpx_relation_greater_equal) | 0);  /* check that clingolpx_relation_greater_equal is an integer */
+  return n;
+}
+
+static int _cffi_const_clingolpx_relation_equal(unsigned long long *o)
+{
+  int n = (clingolpx_relation_equal) <= 0;
+  *o = (unsigned long long)((clingolpx_relation_equal) | 0);  /* check that clingolpx_relation_equal is an integer */
+  return n;
+}
+
+static int _cffi_const_clingolpx_relation_less(unsigned long long *o)
+{
+  int n = (clingolpx_relation_less) <= 0;
+  *o = (unsigned long long)((clingolpx_relation_less) | 0);  /* check that clingolpx_relation_less is an integer */
+  return n;
+}
+
+static int _cffi_const_clingolpx_relation_greater(unsigned long long *o)
+{
+  int n = (clingolpx_relation_greater) <= 0;
+  *o = (unsigned long long)((clingolpx_relation_greater) | 0);  /* check that clingolpx_relation_greater is an integer */
+  return n;
+}
+
 static int _cffi_const_clingolpx_value_type_int(unsigned long long *o)
 {
   int n = (clingolpx_value_type_int) <= 0;
@@ -666,6 +745,111 @@ static _Bool pyclingolpx_rewrite(clingo_ast_t * a0, void * a1)
   return *(_Bool *)p;
 }
 
+static _Bool _cffi_d_clingolpx_add_constraint(clingolpx_theory_t * x0, int32_t x1, uint64_t const * x2, int64_t const * x3, int64_t const * x4, size_t x5, int x6, int64_t x7, int64_t x8)
+{
+  return clingolpx_add_constraint(x0, x1, x2, x3, x4, x5, x6, x7, x8);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_clingolpx_add_constraint(PyObject *self, PyObject *args)
+{
+  clingolpx_theory_t * x0;
+  int32_t x1;
+  uint64_t const * x2;
+  int64_t const * x3;
+  int64_t const * x4;
+  size_t x5;
+  int x6;
+  int64_t x7;
+  int64_t x8;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  _Bool result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+  PyObject *arg4;
+  PyObject *arg5;
+  PyObject *arg6;
+  PyObject *arg7;
+  PyObject *arg8;
+
+  if (!PyArg_UnpackTuple(args, "clingolpx_add_constraint", 9, 9, &arg0, &arg1, &arg2, &arg3, &arg4, &arg5, &arg6, &arg7, &arg8))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(8), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (clingolpx_theory_t *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(8), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, int32_t);
+  if (x1 == (int32_t)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(41), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (uint64_t const *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(41), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(42), arg3, (char **)&x3);
+  if (datasize != 0) {
+    x3 = ((size_t)datasize) <= 640 ? (int64_t const *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(42), arg3, (char **)&x3,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(42), arg4, (char **)&x4);
+  if (datasize != 0) {
+    x4 = ((size_t)datasize) <= 640 ? (int64_t const *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(42), arg4, (char **)&x4,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x5 = _cffi_to_c_int(arg5, size_t);
+  if (x5 == (size_t)-1 && PyErr_Occurred())
+    return NULL;
+
+  x6 = _cffi_to_c_int(arg6, int);
+  if (x6 == (int)-1 && PyErr_Occurred())
+    return NULL;
+
+  x7 = _cffi_to_c_int(arg7, int64_t);
+  if (x7 == (int64_t)-1 && PyErr_Occurred())
+    return NULL;
+
+  x8 = _cffi_to_c_int(arg8, int64_t);
+  if (x8 == (int64_t)-1 && PyErr_Occurred())
+    return NULL;
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = clingolpx_add_constraint(x0, x1, x2, x3, x4, x5, x6, x7, x8); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c__Bool(result);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_clingolpx_add_constraint _cffi_d_clingolpx_add_constraint
+#endif
+
 static void _cffi_d_clingolpx_assignment_begin(clingolpx_theory_t * x0, uint32_t x1, size_t * x2)
 {
   clingolpx_assignment_begin(x0, x1, x2);
@@ -700,10 +884,10 @@ _cffi_f_clingolpx_assignment_begin(PyObject *self, PyObject *args)
     return NULL;
 
   datasize = _cffi_prepare_pointer_call_argument(
-      _cffi_type(41), arg2, (char **)&x2);
+      _cffi_type(59), arg2, (char **)&x2);
   if (datasize != 0) {
     x2 = ((size_t)datasize) <= 640 ? (size_t *)alloca((size_t)datasize) : NULL;
-    if (_cffi_convert_array_argument(_cffi_type(41), arg2, (char **)&x2,
+    if (_cffi_convert_array_argument(_cffi_type(59), arg2, (char **)&x2,
             datasize, &large_args_free) < 0)
       return NULL;
   }
@@ -723,6 +907,244 @@ _cffi_f_clingolpx_assignment_begin(PyObject *self, PyObject *args)
 #  define _cffi_f_clingolpx_assignment_begin _cffi_d_clingolpx_assignment_begin
 #endif
 
+static _Bool _cffi_d_clingolpx_assignment_get_arrays(clingolpx_theory_t * x0, uint32_t x1, size_t x2, int64_t * x3, int64_t * x4, double * x5)
+{
+  return clingolpx_assignment_get_arrays(x0, x1, x2, x3, x4, x5);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_clingolpx_assignment_get_arrays(PyObject *self, PyObject *args)
+{
+  clingolpx_theory_t * x0;
+  uint32_t x1;
+  size_t x2;
+  int64_t * x3;
+  int64_t * x4;
+  double * x5;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  _Bool result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+  PyObject *arg4;
+  PyObject *arg5;
+
+  if (!PyArg_UnpackTuple(args, "clingolpx_assignment_get_arrays", 6, 6, &arg0, &arg1, &arg2, &arg3, &arg4, &arg5))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(8), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (clingolpx_theory_t *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(8), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, uint32_t);
+  if (x1 == (uint32_t)-1 && PyErr_Occurred())
+    return NULL;
+
+  x2 = _cffi_to_c_int(arg2, size_t);
+  if (x2 == (size_t)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(83), arg3, (char **)&x3);
+  if (datasize != 0) {
+    x3 = ((size_t)datasize) <= 640 ? (int64_t *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(83), arg3, (char **)&x3,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(83), arg4, (char **)&x4);
+  if (datasize != 0) {
+    x4 = ((size_t)datasize) <= 640 ? (int64_t *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(83), arg4, (char **)&x4,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(85), arg5, (char **)&x5);
+  if (datasize != 0) {
+    x5 = ((size_t)datasize) <= 640 ? (double *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(85), arg5, (char **)&x5,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = clingolpx_assignment_get_arrays(x0, x1, x2, x3, x4, x5); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c__Bool(result);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_clingolpx_assignment_get_arrays _cffi_d_clingolpx_assignment_get_arrays
+#endif
+
+static _Bool _cffi_d_clingolpx_assignment_get_objective(clingolpx_theory_t * x0, uint32_t x1, _Bool * x2, clingolpx_value_t * x3, _Bool * x4)
+{
+  return clingolpx_assignment_get_objective(x0, x1, x2, x3, x4);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_clingolpx_assignment_get_objective(PyObject *self, PyObject *args)
+{
+  clingolpx_theory_t * x0;
+  uint32_t x1;
+  _Bool * x2;
+  clingolpx_value_t * x3;
+  _Bool * x4;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  _Bool result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+  PyObject *arg4;
+
+  if (!PyArg_UnpackTuple(args, "clingolpx_assignment_get_objective", 5, 5, &arg0, &arg1, &arg2, &arg3, &arg4))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(8), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (clingolpx_theory_t *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(8), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, uint32_t);
+  if (x1 == (uint32_t)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(52), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (_Bool *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(52), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(53), arg3, (char **)&x3);
+  if (datasize != 0) {
+    x3 = ((size_t)datasize) <= 640 ? (clingolpx_value_t *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(53), arg3, (char **)&x3,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(52), arg4, (char **)&x4);
+  if (datasize != 0) {
+    x4 = ((size_t)datasize) <= 640 ? (_Bool *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(52), arg4, (char **)&x4,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = clingolpx_assignment_get_objective(x0, x1, x2, x3, x4); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c__Bool(result);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_clingolpx_assignment_get_objective _cffi_d_clingolpx_assignment_get_objective
+#endif
+
+static _Bool _cffi_d_clingolpx_assignment_get_shown(clingolpx_theory_t * x0, uint32_t x1, size_t const * * x2, size_t * x3)
+{
+  return clingolpx_assignment_get_shown(x0, x1, x2, x3);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_clingolpx_assignment_get_shown(PyObject *self, PyObject *args)
+{
+  clingolpx_theory_t * x0;
+  uint32_t x1;
+  size_t const * * x2;
+  size_t * x3;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  _Bool result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+
+  if (!PyArg_UnpackTuple(args, "clingolpx_assignment_get_shown", 4, 4, &arg0, &arg1, &arg2, &arg3))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(8), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (clingolpx_theory_t *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(8), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, uint32_t);
+  if (x1 == (uint32_t)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(64), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (size_t const * *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(64), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(59), arg3, (char **)&x3);
+  if (datasize != 0) {
+    x3 = ((size_t)datasize) <= 640 ? (size_t *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(59), arg3, (char **)&x3,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = clingolpx_assignment_get_shown(x0, x1, x2, x3); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c__Bool(result);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_clingolpx_assignment_get_shown _cffi_d_clingolpx_assignment_get_shown
+#endif
+
 static void _cffi_d_clingolpx_assignment_get_value(clingolpx_theory_t * x0, uint32_t x1, size_t x2, clingolpx_value_t * x3)
 {
   clingolpx_assignment_get_value(x0, x1, x2, x3);
@@ -763,10 +1185,10 @@ _cffi_f_clingolpx_assignment_get_value(PyObject *self, PyObject *args)
     return NULL;
 
   datasize = _cffi_prepare_pointer_call_argument(
-      _cffi_type(66), arg3, (char **)&x3);
+      _cffi_type(53), arg3, (char **)&x3);
   if (datasize != 0) {
     x3 = ((size_t)datasize) <= 640 ? (clingolpx_value_t *)alloca((size_t)datasize) : NULL;
-    if (_cffi_convert_array_argument(_cffi_type(66), arg3, (char **)&x3,
+    if (_cffi_convert_array_argument(_cffi_type(53), arg3, (char **)&x3,
             datasize, &large_args_free) < 0)
       return NULL;
   }
@@ -786,6 +1208,82 @@ _cffi_f_clingolpx_assignment_get_value(PyObject *self, PyObject *args)
 #  define _cffi_f_clingolpx_assignment_get_value _cffi_d_clingolpx_assignment_get_value
 #endif
 
+static _Bool _cffi_d_clingolpx_assignment_get_values(clingolpx_theory_t * x0, uint32_t x1, size_t const * x2, size_t x3, clingolpx_rational_t * x4)
+{
+  return clingolpx_assignment_get_values(x0, x1, x2, x3, x4);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_clingolpx_assignment_get_values(PyObject *self, PyObject *args)
+{
+  clingolpx_theory_t * x0;
+  uint32_t x1;
+  size_t const * x2;
+  size_t x3;
+  clingolpx_rational_t * x4;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  _Bool result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+  PyObject *arg2;
+  PyObject *arg3;
+  PyObject *arg4;
+
+  if (!PyArg_UnpackTuple(args, "clingolpx_assignment_get_values", 5, 5, &arg0, &arg1, &arg2, &arg3, &arg4))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(8), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (clingolpx_theory_t *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(8), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, uint32_t);
+  if (x1 == (uint32_t)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(70), arg2, (char **)&x2);
+  if (datasize != 0) {
+    x2 = ((size_t)datasize) <= 640 ? (size_t const *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(70), arg2, (char **)&x2,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x3 = _cffi_to_c_int(arg3, size_t);
+  if (x3 == (size_t)-1 && PyErr_Occurred())
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(72), arg4, (char **)&x4);
+  if (datasize != 0) {
+    x4 = ((size_t)datasize) <= 640 ? (clingolpx_rational_t *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(72), arg4, (char **)&x4,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = clingolpx_assignment_get_values(x0, x1, x2, x3, x4); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c__Bool(result);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_clingolpx_assignment_get_values _cffi_d_clingolpx_assignment_get_values
+#endif
+
 static _Bool _cffi_d_clingolpx_assignment_has_value(clingolpx_theory_t * x0, uint32_t x1, size_t x2)
 {
   return clingolpx_assignment_has_value(x0, x1, x2);
@@ -876,10 +1374,10 @@ _cffi_f_clingolpx_assignment_next(PyObject *self, PyObject *args)
     return NULL;
 
   datasize = _cffi_prepare_pointer_call_argument(
-      _cffi_type(41), arg2, (char **)&x2);
+      _cffi_type(59), arg2, (char **)&x2);
   if (datasize != 0) {
     x2 = ((size_t)datasize) <= 640 ? (size_t *)alloca((size_t)datasize) : NULL;
-    if (_cffi_convert_array_argument(_cffi_type(41), arg2, (char **)&x2,
+    if (_cffi_convert_array_argument(_cffi_type(59), arg2, (char **)&x2,
             datasize, &large_args_free) < 0)
       return NULL;
   }
@@ -899,6 +1397,54 @@ _cffi_f_clingolpx_assignment_next(PyObject *self, PyObject *args)
 #  define _cffi_f_clingolpx_assignment_next _cffi_d_clingolpx_assignment_next
 #endif
 
+static size_t _cffi_d_clingolpx_assignment_size(clingolpx_theory_t * x0, uint32_t x1)
+{
+  return clingolpx_assignment_size(x0, x1);
+}
+#ifndef PYPY_VERSION
+static PyObject *
+_cffi_f_clingolpx_assignment_size(PyObject *self, PyObject *args)
+{
+  clingolpx_theory_t * x0;
+  uint32_t x1;
+  Py_ssize_t datasize;
+  struct _cffi_freeme_s *large_args_free = NULL;
+  size_t result;
+  PyObject *pyresult;
+  PyObject *arg0;
+  PyObject *arg1;
+
+  if (!PyArg_UnpackTuple(args, "clingolpx_assignment_size", 2, 2, &arg0, &arg1))
+    return NULL;
+
+  datasize = _cffi_prepare_pointer_call_argument(
+      _cffi_type(8), arg0, (char **)&x0);
+  if (datasize != 0) {
+    x0 = ((size_t)datasize) <= 640 ? (clingolpx_theory_t *)alloca((size_t)datasize) : NULL;
+    if (_cffi_convert_array_argument(_cffi_type(8), arg0, (char **)&x0,
+            datasize, &large_args_free) < 0)
+      return NULL;
+  }
+
+  x1 = _cffi_to_c_int(arg1, uint32_t);
+  if (x1 == (uint32_t)-1 && PyErr_Occurred())
+    return NULL;
+
+  Py_BEGIN_ALLOW_THREADS
+  _cffi_restore_errno();
+  { result = clingolpx_assignment_size(x0, x1); }
+  _cffi_save_errno();
+  Py_END_ALLOW_THREADS
+
+  (void)self; /* unused */
+  pyresult = _cffi_from_c_int(result, size_t);
+  if (large_args_free != NULL) _cffi_free_array_arguments(large_args_free);
+  return pyresult;
+}
+#else
+#  define _cffi_f_clingolpx_assignment_size _cffi_d_clingolpx_assignment_size
+#endif
+
 static _Bool _cffi_d_clingolpx_configure(clingolpx_theory_t * x0, char const * x1, char const * x2)
 {
   return clingolpx_configure(x0, x1, x2);
@@ -1123,10 +1669,10 @@ _cffi_f_clingolpx_lookup_symbol(PyObject *self, PyObject *args)
     return NULL;
 
   datasize = _cffi_prepare_pointer_call_argument(
-      _cffi_type(41), arg2, (char **)&x2);
+      _cffi_type(59), arg2, (char **)&x2);
   if (datasize != 0) {
     x2 = ((size_t)datasize) <= 640 ? (size_t *)alloca((size_t)datasize) : NULL;
-    if (_cffi_convert_array_argument(_cffi_type(41), arg2, (char **)&x2,
+    if (_cffi_convert_array_argument(_cffi_type(59), arg2, (char **)&x2,
             datasize, &large_args_free) < 0)
       return NULL;
   }
@@ -1551,28 +2097,28 @@ _cffi_f_clingolpx_version(PyObject *self, PyObject *args)
     return NULL;
 
   datasize = _cffi_prepare_pointer_call_argument(
-      _cffi_type(69), arg0, (char **)&x0);
+      _cffi_type(112), arg0, (char **)&x0);
   if (datasize != 0) {
     x0 = ((size_t)datasize) <= 640 ? (int *)alloca((size_t)datasize) : NULL;
-    if (_cffi_convert_array_argument(_cffi_type(69), arg0, (char **)&x0,
+    if (_cffi_convert_array_argument(_cffi_type(112), arg0, (char **)&x0,
             datasize, &large_args_free) < 0)
       return NULL;
   }
 
   datasize = _cffi_prepare_pointer_call_argument(
-      _cffi_type(69), arg1, (char **)&x1);
+      _cffi_type(112), arg1, (char **)&x1);
   if (datasize != 0) {
     x1 = ((size_t)datasize) <= 640 ? (int *)alloca((size_t)datasize) : NULL;
-    if (_cffi_convert_array_argument(_cffi_type(69), arg1, (char **)&x1,
+    if (_cffi_convert_array_argument(_cffi_type(112), arg1, (char **)&x1,
             datasize, &large_args_free) < 0)
       return NULL;
   }
 
   datasize = _cffi_prepare_pointer_call_argument(
-      _cffi_type(69), arg2, (char **)&x2);
+      _cffi_type(112), arg2, (char **)&x2);
   if (datasize != 0) {
     x2 = ((size_t)datasize) <= 640 ? (int *)alloca((size_t)datasize) : NULL;
-    if (_cffi_convert_array_argument(_cffi_type(69), arg2, (char **)&x2,
+    if (_cffi_convert_array_argument(_cffi_type(112), arg2, (char **)&x2,
             datasize, &large_args_free) < 0)
       return NULL;
   }
@@ -1592,6 +2138,18 @@ _cffi_f_clingolpx_version(PyObject *self, PyObject *args)
 #  define _cffi_f_clingolpx_version _cffi_d_clingolpx_version
 #endif
 
+_CFFI_UNUSED_FN
+static void _cffi_checkfld__clingolpx_rational_t(clingolpx_rational_t *p)
+{
+  /* only to generate compile-time warnings or errors */
+  (void)p;
+  (void)((p->numerator) | 0);  /* check that 'clingolpx_rational_t.numerator' is an integer */
+  (void)((p->denominator) | 0);  /* check that 'clingolpx_rational_t.denominator' is an integer */
+  (void)((p->epsilon_numerator) | 0);  /* check that 'clingolpx_rational_t.epsilon_numerator' is an integer */
+  (void)((p->epsilon_denominator) | 0);  /* check that 'clingolpx_rational_t.epsilon_denominator' is an integer */
+}
+struct _cffi_align__clingolpx_rational_t { char x; clingolpx_rational_t y; };
+
 _CFFI_UNUSED_FN
 static void _cffi_checkfld__clingolpx_value_t(clingolpx_value_t *p)
 {
@@ -1605,80 +2163,111 @@ static void _cffi_checkfld__clingolpx_value_t(clingolpx_value_t *p)
 struct _cffi_align__clingolpx_value_t { char x; clingolpx_value_t y; };
 
 static const struct _cffi_global_s _cffi_globals[] = {
-  { "clingolpx_assignment_begin", (void *)_cffi_f_clingolpx_assignment_begin, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 57), (void *)_cffi_d_clingolpx_assignment_begin },
-  { "clingolpx_assignment_get_value", (void *)_cffi_f_clingolpx_assignment_get_value, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 62), (void *)_cffi_d_clingolpx_assignment_get_value },
-  { "clingolpx_assignment_has_value", (void *)_cffi_f_clingolpx_assignment_has_value, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 43), (void *)_cffi_d_clingolpx_assignment_has_value },
-  { "clingolpx_assignment_next", (void *)_cffi_f_clingolpx_assignment_next, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 38), (void *)_cffi_d_clingolpx_assignment_next },
+  { "clingolpx_add_constraint", (void *)_cffi_f_clingolpx_add_constraint, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 38), (void *)_cffi_d_clingolpx_add_constraint },
+  { "clingolpx_assignment_begin", (void *)_cffi_f_clingolpx_assignment_begin, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 100), (void *)_cffi_d_clingolpx_assignment_begin },
+  { "clingolpx_assignment_get_arrays", (void *)_cffi_f_clingolpx_assignment_get_arrays, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 79), (void *)_cffi_d_clingolpx_assignment_get_arrays },
+  { "clingolpx_assignment_get_objective", (void *)_cffi_f_clingolpx_assignment_get_objective, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 49), (void *)_cffi_d_clingolpx_assignment_get_objective },
+  { "clingolpx_assignment_get_shown", (void *)_cffi_f_clingolpx_assignment_get_shown, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 61), (void *)_cffi_d_clingolpx_assignment_get_shown },
+  { "clingolpx_assignment_get_value", (void *)_cffi_f_clingolpx_assignment_get_value, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 105), (void *)_cffi_d_clingolpx_assignment_get_value },
+  { "clingolpx_assignment_get_values", (void *)_cffi_f_clingolpx_assignment_get_values, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 67), (void *)_cffi_d_clingolpx_assignment_get_values },
+  { "clingolpx_assignment_has_value", (void *)_cffi_f_clingolpx_assignment_has_value, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 74), (void *)_cffi_d_clingolpx_assignment_has_value },
+  { "clingolpx_assignment_next", (void *)_cffi_f_clingolpx_assignment_next, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 56), (void *)_cffi_d_clingolpx_assignment_next },
+  { "clingolpx_assignment_size", (void *)_cffi_f_clingolpx_assignment_size, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 92), (void *)_cffi_d_clingolpx_assignment_size },
   { "clingolpx_configure", (void *)_cffi_f_clingolpx_configure, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 10), (void *)_cffi_d_clingolpx_configure },
   { "clingolpx_create", (void *)_cffi_f_clingolpx_create, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 4), (void *)_cffi_d_clingolpx_create },
   { "clingolpx_destroy", (void *)_cffi_f_clingolpx_destroy, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 7), (void *)_cffi_d_clingolpx_destroy },
-  { "clingolpx_get_symbol", (void *)_cffi_f_clingolpx_get_symbol, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 53), (void *)_cffi_d_clingolpx_get_symbol },
-  { "clingolpx_lookup_symbol", (void *)_cffi_f_clingolpx_lookup_symbol, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 48), (void *)_cffi_d_clingolpx_lookup_symbol },
+  { "clingolpx_get_symbol", (void *)_cffi_f_clingolpx_get_symbol, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 96), (void *)_cffi_d_clingolpx_get_symbol },
+  { "clingolpx_lookup_symbol", (void *)_cffi_f_clingolpx_lookup_symbol, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 87), (void *)_cffi_d_clingolpx_lookup_symbol },
   { "clingolpx_on_model", (void *)_cffi_f_clingolpx_on_model, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 25), (void *)_cffi_d_clingolpx_on_model },
   { "clingolpx_on_statistics", (void *)_cffi_f_clingolpx_on_statistics, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 33), (void *)_cffi_d_clingolpx_on_statistics },
   { "clingolpx_prepare", (void *)_cffi_f_clingolpx_prepare, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 21), (void *)_cffi_d_clingolpx_prepare },
   { "clingolpx_register", (void *)_cffi_f_clingolpx_register, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 21), (void *)_cffi_d_clingolpx_register },
   { "clingolpx_register_options", (void *)_cffi_f_clingolpx_register_options, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 29), (void *)_cffi_d_clingolpx_register_options },
+  { "clingolpx_relation_equal", (void *)_cffi_const_clingolpx_relation_equal, _CFFI_OP(_CFFI_OP_ENUM, -1), (void *)0 },
+  { "clingolpx_relation_greater", (void *)_cffi_const_clingolpx_relation_greater, _CFFI_OP(_CFFI_OP_ENUM, -1), (void *)0 },
+  { "clingolpx_relation_greater_equal", (void *)_cffi_const_clingolpx_relation_greater_equal, _CFFI_OP(_CFFI_OP_ENUM, -1), (void *)0 },
+  { "clingolpx_relation_less", (void *)_cffi_const_clingolpx_relation_less, _CFFI_OP(_CFFI_OP_ENUM, -1), (void *)0 },
+  { "clingolpx_relation_less_equal", (void *)_cffi_const_clingolpx_relation_less_equal, _CFFI_OP(_CFFI_OP_ENUM, -1), (void *)0 },
   { "clingolpx_rewrite_ast", (void *)_cffi_f_clingolpx_rewrite_ast, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 15), (void *)_cffi_d_clingolpx_rewrite_ast },
   { "clingolpx_validate_options", (void *)_cffi_f_clingolpx_validate_options, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_O, 7), (void *)_cffi_d_clingolpx_validate_options },
   { "clingolpx_value_type_double", (void *)_cffi_const_clingolpx_value_type_double, _CFFI_OP(_CFFI_OP_ENUM, -1), (void *)0 },
   { "clingolpx_value_type_int", (void *)_cffi_const_clingolpx_value_type_int, _CFFI_OP(_CFFI_OP_ENUM, -1), (void *)0 },
   { "clingolpx_value_type_symbol", (void *)_cffi_const_clingolpx_value_type_symbol, _CFFI_OP(_CFFI_OP_ENUM, -1), (void *)0 },
-  { "clingolpx_version", (void *)_cffi_f_clingolpx_version, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 68), (void *)_cffi_d_clingolpx_version },
+  { "clingolpx_version", (void *)_cffi_f_clingolpx_version, _CFFI_OP(_CFFI_OP_CPYTHON_BLTN_V, 111), (void *)_cffi_d_clingolpx_version },
   { "pyclingolpx_rewrite", (void *)&_cffi_externpy__pyclingolpx_rewrite, _CFFI_OP(_CFFI_OP_EXTERN_PYTHON, 18), (void *)pyclingolpx_rewrite },
 };
 
 static const struct _cffi_field_s _cffi_fields[] = {
+  { "numerator", offsetof(clingolpx_rational_t, numerator),
+                 sizeof(((clingolpx_rational_t *)0)->numerator),
+                 _CFFI_OP(_CFFI_OP_NOOP, 46) },
+  { "denominator", offsetof(clingolpx_rational_t, denominator),
+                   sizeof(((clingolpx_rational_t *)0)->denominator),
+                   _CFFI_OP(_CFFI_OP_NOOP, 46) },
+  { "epsilon_numerator", offsetof(clingolpx_rational_t, epsilon_numerator),
+                         sizeof(((clingolpx_rational_t *)0)->epsilon_numerator),
+                         _CFFI_OP(_CFFI_OP_NOOP, 46) },
+  { "epsilon_denominator", offsetof(clingolpx_rational_t, epsilon_denominator),
+                           sizeof(((clingolpx_rational_t *)0)->epsilon_denominator),
+                           _CFFI_OP(_CFFI_OP_NOOP, 46) },
   { "type", offsetof(clingolpx_value_t, type),
             sizeof(((clingolpx_value_t *)0)->type),
-            _CFFI_OP(_CFFI_OP_NOOP, 85) },
+            _CFFI_OP(_CFFI_OP_NOOP, 45) },
   { "int_number", offsetof(clingolpx_value_t, int_number),
                   sizeof(((clingolpx_value_t *)0)->int_number),
-                  _CFFI_OP(_CFFI_OP_NOOP, 85) },
+                  _CFFI_OP(_CFFI_OP_NOOP, 45) },
   { "double_number", offsetof(clingolpx_value_t, double_number),
                      sizeof(((clingolpx_value_t *)0)->double_number),
-                     _CFFI_OP(_CFFI_OP_NOOP, 83) },
+                     _CFFI_OP(_CFFI_OP_NOOP, 127) },
   { "symbol", offsetof(clingolpx_value_t, symbol),
               sizeof(((clingolpx_value_t *)0)->symbol),
-              _CFFI_OP(_CFFI_OP_NOOP, 50) },
+              _CFFI_OP(_CFFI_OP_NOOP, 89) },
 };
 
 static const struct _cffi_struct_union_s _cffi_struct_unions[] = {
-  { "clingo_ast", 76, _CFFI_F_OPAQUE,
+  { "clingo_ast", 119, _CFFI_F_OPAQUE,
     (size_t)-1, -1, -1, 0 /* opaque */ },
-  { "clingo_ast_statement", 75, _CFFI_F_OPAQUE,
+  { "clingo_ast_statement", 118, _CFFI_F_OPAQUE,
     (size_t)-1, -1, -1, 0 /* opaque */ },
-  { "clingo_control", 77, _CFFI_F_OPAQUE,
+  { "clingo_control", 120, _CFFI_F_OPAQUE,
     (size_t)-1, -1, -1, 0 /* opaque */ },
-  { "clingo_model", 78, _CFFI_F_OPAQUE,
+  { "clingo_model", 121, _CFFI_F_OPAQUE,
     (size_t)-1, -1, -1, 0 /* opaque */ },
-  { "clingo_options", 79, _CFFI_F_OPAQUE,
+  { "clingo_options", 122, _CFFI_F_OPAQUE,
     (size_t)-1, -1, -1, 0 /* opaque */ },
-  { "clingo_statistics", 80, _CFFI_F_OPAQUE,
+  { "clingo_statistics", 123, _CFFI_F_OPAQUE,
     (size_t)-1, -1, -1, 0 /* opaque */ },
-  { "clingolpx_theory", 81, _CFFI_F_OPAQUE,
+  { "clingolpx_rational", 124, _CFFI_F_CHECK_FIELDS,
+    sizeof(clingolpx_rational_t), offsetof(struct _cffi_align__clingolpx_rational_t, y), 0, 4 },
+  { "clingolpx_theory", 125, _CFFI_F_OPAQUE,
     (size_t)-1, -1, -1, 0 /* opaque */ },
-  { "clingolpx_value", 82, 0,
-    sizeof(clingolpx_value_t), offsetof(struct _cffi_align__clingolpx_value_t, y), 0, 4 },
+  { "clingolpx_value", 126, 0,
+    sizeof(clingolpx_value_t), offsetof(struct _cffi_align__clingolpx_value_t, y), 4, 4 },
 };
 
 static const struct _cffi_enum_s _cffi_enums[] = {
-  { "clingolpx_value_type", 84, _cffi_prim_int(sizeof(enum clingolpx_value_type), ((enum clingolpx_value_type)-1) <= 0),
+  { "clingolpx_relation", 128, _cffi_prim_int(sizeof(enum clingolpx_relation), ((enum clingolpx_relation)-1) <= 0),
+    "clingolpx_relation_less_equal,clingolpx_relation_greater_equal,clingolpx_relation_equal,clingolpx_relation_less,"
+    "clingolpx_relation_greater" },
+  { "clingolpx_value_type", 129, _cffi_prim_int(sizeof(enum clingolpx_value_type), ((enum clingolpx_value_type)-1) <= 0),
     "clingolpx_value_type_int,clingolpx_value_type_double,clingolpx_value_type_symbol" },
 };
 
 static const struct _cffi_typename_s _cffi_typenames[] = {
-  { "clingo_ast_statement_t", 75 },
-  { "clingo_ast_t", 76 },
-  { "clingo_control_t", 77 },
-  { "clingo_model_t", 78 },
-  { "clingo_options_t", 79 },
-  { "clingo_statistics_t", 80 },
-  { "clingo_symbol_t", 50 },
+  { "clingo_ast_statement_t", 118 },
+  { "clingo_ast_t", 119 },
+  { "clingo_control_t", 120 },
+  { "clingo_literal_t", 40 },
+  { "clingo_model_t", 121 },
+  { "clingo_options_t", 122 },
+  { "clingo_statistics_t", 123 },
+  { "clingo_symbol_t", 89 },
   { "clingolpx_ast_callback_t", 18 },
-  { "clingolpx_theory_t", 81 },
-  { "clingolpx_value_t", 82 },
-  { "clingolpx_value_type_t", 85 },
+  { "clingolpx_rational_t", 124 },
+  { "clingolpx_relation_t", 45 },
+  { "clingolpx_theory_t", 125 },
+  { "clingolpx_value_t", 126 },
+  { "clingolpx_value_type_t", 45 },
 };
 
 static const struct _cffi_type_context_s _cffi_type_context = {
@@ -1688,12 +2277,12 @@ static const struct _cffi_type_context_s _cffi_type_context = {
   _cffi_struct_unions,
   _cffi_enums,
   _cffi_typenames,
-  21,  /* num_globals */
-  8,  /* num_struct_unions */
-  1,  /* num_enums */
-  11,  /* num_typenames */
+  32,  /* num_globals */
+  9,  /* num_struct_unions */
+  2,  /* num_enums */
+  14,  /* num_typenames */
   NULL,  /* no includes */
-  87,  /* num_types */
+  131,  /* num_types */
   1,  /* flags */
 };
 
@@ -2,14 +2,97 @@
 This module provides a clingo.Theory class for a LPX theory.
 '''
 
+from fractions import Fraction
+from typing import List, Sequence, Tuple, Union
+
+from clingo._internal import _handle_error
+from clingo.symbol import Symbol
 from clingo.theory import Theory
 from ._clingolpx import lib as _lib, ffi as _ffi
 
 __all__ = ['ClingoLPXTheory']
 
+_RELATIONS = {
+    '<=': _lib.clingolpx_relation_less_equal,
+    '>=': _lib.clingolpx_relation_greater_equal,
+    '=': _lib.clingolpx_relation_equal,
+    '<': _lib.clingolpx_relation_less,
+    '>': _lib.clingolpx_relation_greater,
+}
+
 class ClingoLPXTheory(Theory):
     '''
     The DL theory.
     '''
     def __init__(self):
         super().__init__("clingolpx", _lib, _ffi)
+        self.__symbols: List[Symbol] = []
+
+    def assignment_symbols(self, thread_id: int = 0) -> List[Symbol]:
+        '''
+        Get the symbols associated with the values returned by
+        `assignment_fractions` and `assignment_floats`.
+
+        The list includes auxiliary variables introduced by the theory, whose
+        symbols are numbers; they can be skipped by checking for
+        `SymbolType.Number`. The returned list is shared between calls and
+        must not be modified.
+        '''
+        for index in range(len(self.__symbols), _lib.clingolpx_assignment_size(self._theory, thread_id)):
+            self.__symbols.append(Symbol(_lib.clingolpx_get_symbol(self._theory, index + 1)))
+        return self.__symbols
+
+    def assignment_fractions(self, thread_id: int = 0) -> Tuple[memoryview, memoryview]:
+        '''
+        Get the numerators and denominators of the values of all variables as
+        arrays of 64 bit integers in the order of `assignment_symbols`.
+
+        The arrays are filled in one call and exposed via the buffer protocol
+        without copying, e.g., they can be passed to `numpy.frombuffer`.
+        Epsilon components in strict mode are ignored. Like
+        `assignment_symbols`, the arrays include the values of auxiliary
+        variables.
+
+        Raises a `RuntimeError` if a value does not fit into 64 bit integers;
+        `assignment_floats` does not have this restriction.
+        '''
+        size = _lib.clingolpx_assignment_size(self._theory, thread_id)
+        num = _ffi.new('int64_t[]', size)
+        den = _ffi.new('int64_t[]', size)
+        _handle_error(_lib.clingolpx_assignment_get_arrays(self._theory, thread_id, size, num, den, _ffi.NULL))
+        return memoryview(_ffi.buffer(num)).cast('q'), memoryview(_ffi.buffer(den)).cast('q')
+
+    def assignment_floats(self, thread_id: int = 0) -> memoryview:
+        '''
+        Get the values of all variables as an array of doubles in the order of
+        `assignment_symbols`.
+
+        Values are converted directly from the exact rationals and the array
+        includes the values of auxiliary variables. See
+        `assignment_fractions`.
+        '''
+        size = _lib.clingolpx_assignment_size(self._theory, thread_id)
+        values = _ffi.new('double[]', size)
+        _handle_error(_lib.clingolpx_assignment_get_arrays(self._theory, thread_id, size, _ffi.NULL, _ffi.NULL,
+                                                           values))
+        return memoryview(_ffi.buffer(values)).cast('d')
+
+    def add_constraint(self, literal: int, terms: Sequence[Tuple[Union[int, Fraction], Symbol]], relation: str,
+                       rhs: Union[int, Fraction] = 0):
+        '''
+        Add the constraint `sum(co * var for co, var in terms) relation rhs`
+        guarded by the given program literal.
+
+        The theory has to be registered before adding constraints. The
+        constraint is passed to the solvers when solving next. Relations are
+        given as strings among `<=`, `>=`, `=`, `<`, and `>` where the latter
+        two require option `--strict`.
+        '''
+        cos = [Fraction(co) for co, _ in terms]
+        rhs = Fraction(rhs)
+        _handle_error(_lib.clingolpx_add_constraint(
+            self._theory, literal,
+            _ffi.new('clingo_symbol_t[]', [var._rep for _, var in terms]),
+            _ffi.new('int64_t[]', [co.numerator for co in cos]),
+            _ffi.new('int64_t[]', [co.denominator for co in cos]),
+            len(cos), _RELATIONS[relation], rhs.numerator, rhs.denominator))
@@ -15,6 +15,7 @@ code = '\n'.join(cnt)
 
 ffibuilder.cdef(f'''\
 typedef uint64_t clingo_symbol_t;
+typedef int32_t clingo_literal_t;
 typedef struct clingo_ast_statement clingo_ast_statement_t;
 typedef struct clingo_ast clingo_ast_t;
 typedef struct clingo_control clingo_control_t;